@@ -7,6 +7,7 @@
 #include "core/data_types.h"
 #include "models/clustering/k_means_clusterer.h" 
 #include "models/linear/logistic_regression.h"
+#include "models/linear/multi_linear_regression.h"
 #include "models/decision_tree/decision_tree.h"
 #include "models/neural/neural_network.h"
 
@@ -22,45 +23,6 @@ using aicpp::DataPoint;
 #include "models/linear/logistic_regression.h"
 
 
-// --- Multi-Linear Regression (functions from multi_linear_regression.cpp) ---
-double mlr_predict(const std::vector<double>& features, const std::vector<double>& weights, double bias) {
-
-    double result = bias;
-    for(size_t i = 0; i < weights.size(); ++i) result += weights[i] * features[i];
-
-    return result;
-}
-
-double mlr_compute_loss(const std::vector<std::vector<double>>& X, const std::vector<double>& y,
-                        const std::vector<double>& weights, double bias) {
-
-    double total = 0.0;
-    for(size_t i = 0; i < X.size(); ++i) {
-        double pred = mlr_predict(X[i], weights, bias);
-        total += std::pow(pred - y[i], 2);
-    }
-    return total / X.size();
-}
-
-void mlr_update_weights(const std::vector<std::vector<double>>& X, const std::vector<double>& y,
-                        std::vector<double>& weights, double& bias, double lr) {
-    size_t n = X.size();
-    size_t m = weights.size();
-    std::vector<double> grad_w(m, 0.0);
-    double grad_b = 0.0;
-
-    for(size_t i = 0; i < n; ++i) {
-
-        double pred = mlr_predict(X[i], weights, bias);
-        double error = pred - y[i];
-        for(size_t j = 0; j < m; ++j) grad_w[j] += error * X[i][j];
-        grad_b += error;
-    }
-
-    for(size_t j = 0; j < m; ++j) weights[j] -= lr * grad_w[j] / n;
-    bias -= lr * grad_b / n;
-}
-
 // --- Demos ---
 void run_k_means_demo() {
 
@@ -89,24 +51,19 @@ void run_multi_linear_regression_demo() {
     std::cout << "   MULTI-LINEAR REGRESSION DEMO\n";
     std::cout << "==============================\n";
 
-    std::vector<std::vector<double>> X = {{1,2},{2,3},{3,4},{4,5},{5,6}};
-    std::vector<double> y = {13, 18, 23, 28, 33};
-    std::vector<double> weights(X[0].size(), 0.0);
-    double bias = 0.0;
-    double lr = 0.01;
-
-    for(int epoch = 0; epoch < 5000; ++epoch) {
-        mlr_update_weights(X, y, weights, bias, lr);
-        if(epoch % 500 == 0) {
-            double loss = mlr_compute_loss(X, y, weights, bias);
-            std::cout << "Epoch " << epoch << " | Loss: " << loss
-                      << " | w: [" << weights[0] << ", " << weights[1] << "]"
-                      << " | b: " << bias << std::endl;
-        }
-    }
+    std::vector<std::vector<aicpp::real>> X = {{1,2},{2,3},{3,4},{4,5},{5,6}};
+    std::vector<aicpp::real> y = {13, 18, 23, 28, 33};
+
+    // One pass over the data instead of thousands of gradient-descent epochs
+    MultiLinearRegression model(0.01, MultiLinearRegression::Solver::Direct);
+    model.train(X, y, 0);
+
+    const auto& weights = model.weights();
+    std::cout << "w: [" << weights[0] << ", " << weights[1] << "]"
+              << " | b: " << model.bias() << std::endl;
 
-    std::vector<double> new_input = {6,7};
-    double pred = mlr_predict(new_input, weights, bias);
+    std::vector<aicpp::real> new_input = {6,7};
+    double pred = model.predict(new_input);
     std::cout << "Prediction for [6,7]: " << pred << std::endl;
 }
 
@@ -123,7 +80,7 @@ void run_logistic_regression_demo() {
     aicpp::LogisticRegression model(0.1, 1000);
     model.train(data);
 
-    std::vector<double> new_input = {1.5};
+    std::vector<aicpp::real> new_input = {1.5};
     int prediction = model.predict(new_input);
     std::cout << "Prediction for 1.5: " << prediction << std::endl;
 }
@@ -168,8 +125,8 @@ void run_neural_network_demo() {
    // Architecture: input=2, hidden1=32, hidden2=8, output=1
     NeuralNetwork nn({2, 32, 8, 1}, 0.1);
 
-    std::vector<std::vector<double>> X = {{0,0}, {0,1}, {1,0}, {1,1}};
-    std::vector<std::vector<double>> Y = {{0},   {1},   {1},   {0}};
+    std::vector<std::vector<aicpp::real>> X = {{0,0}, {0,1}, {1,0}, {1,1}};
+    std::vector<std::vector<aicpp::real>> Y = {{0},   {1},   {1},   {0}};
 
     nn.train(X, Y, 5000);
 
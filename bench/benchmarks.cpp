@@ -0,0 +1,261 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+#include "core/data_types.h"
+#include "core/dataset.h"
+#include "core/thread_pool.h"
+#include "models/clustering/k_means_clusterer.h"
+#include "models/linear/logistic_regression.h"
+
+using aicpp::Dataset;
+using aicpp::real;
+
+// Benchmark driver for the measurements quoted in the README. Every workload is
+// synthetic and generated from a fixed seed, so runs are repeatable; timings
+// depend on the machine. Configure with -DAICPP_USE_FLOAT=ON for a float build
+// and run the same benchmark in both builds to compare the precisions.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// High-water resident set of this process, in MB
+long peak_rss_mb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024;
+}
+
+// Silences the models' progress logging for the duration of a timed call
+class QuietCout {
+public:
+    QuietCout() : saved_(std::cout.rdbuf(nullptr)) {}
+    ~QuietCout() { std::cout.rdbuf(saved_); }
+private:
+    std::streambuf* saved_;
+};
+
+// n points around k random centers plus sigma·N(0, 1) noise per coordinate. Center
+// coordinates are uniform in ±center_scale, or center_scale·N(0, 1) when normal_centers.
+Dataset gaussian_blobs(size_t n, size_t d, size_t k, double center_scale, bool normal_centers,
+                       double sigma, unsigned seed) {
+
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> normal;
+    std::uniform_real_distribution<double> uniform(-center_scale, center_scale);
+
+    std::vector<double> centers(k * d);
+    for (double& c : centers) c = normal_centers ? center_scale * normal(gen) : uniform(gen);
+
+    Dataset data(n, d);
+    for (size_t i = 0; i < n; ++i) {
+        const double* c = centers.data() + (gen() % k) * d;
+        for (size_t j = 0; j < d; ++j) data.at(i, j) = static_cast<real>(c[j] + sigma * normal(gen));
+    }
+    return data;
+}
+
+void print_header(const char* name) {
+    std::printf("%s | real = %s | %zu threads\n", name, sizeof(real) == sizeof(float) ? "float" : "double",
+                aicpp::ThreadPool::instance().size());
+}
+
+// K-Means, 1M x 16, K = 32, 25 Lloyd iterations
+void bench_kmeans() {
+
+    print_header("kmeans");
+
+    Dataset data = gaussian_blobs(1000000, 16, 32, 8.0, true, 2.0, 7);
+    aicpp::KMeansClusterer km(32, 25);
+    km.set_seed(1);
+
+    Clock::time_point start = Clock::now();
+    {
+        QuietCout quiet;
+        km.train(data);
+    }
+    const double train = seconds_since(start);
+
+    std::printf("data %.0f MB | peak RSS %ld MB | train %.2f s | inertia/N %.4f\n",
+                data.rows() * data.cols() * sizeof(real) / 1e6, peak_rss_mb(), train,
+                km.inertia() / data.rows());
+}
+
+// Logistic Regression, 1M x 32, 50 full-batch gradient-descent epochs
+void bench_logistic() {
+
+    print_header("logistic");
+
+    const size_t n = 1000000, d = 32;
+    std::mt19937 gen(7);
+    std::normal_distribution<double> normal;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<double> w(d);
+    for (double& v : w) v = normal(gen) / 4;
+
+    Dataset data(n, d);
+    std::vector<real> labels(n);
+    for (size_t i = 0; i < n; ++i) {
+        double z = 0.0;
+        for (size_t j = 0; j < d; ++j) {
+            data.at(i, j) = static_cast<real>(normal(gen));
+            z += w[j] * data(i, j);
+        }
+        labels[i] = 1.0 / (1.0 + std::exp(-z)) > uniform(gen) ? 1 : 0;
+    }
+    data.set_labels(labels);
+
+    aicpp::LogisticRegression model(0.5, 50);
+    Clock::time_point start = Clock::now();
+    {
+        QuietCout quiet;
+        model.train(data);
+    }
+    const double train = seconds_since(start);
+
+    std::vector<double> p(n);
+    model.predict_proba_batch(data, p.data());
+    double loss = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double y = data.label(i);
+        loss -= y * std::log(p[i]) + (1.0 - y) * std::log(1.0 - p[i]);
+    }
+
+    std::printf("data %.0f MB | peak RSS %ld MB | train %.2f s | loss %.5f\n",
+                data.rows() * data.cols() * sizeof(real) / 1e6, peak_rss_mb(), train, loss / n);
+}
+
+// K-Means seeding: iterations to convergence and final inertia for each Init
+void bench_seeding() {
+
+    print_header("seeding");
+
+    const size_t d = 16;
+    const double sigma = 2.0;
+    Dataset data = gaussian_blobs(100000, d, 50, 20.0, false, sigma, 7);
+    const char* names[] = {"random", "k-means++", "k-means||"};
+
+    // Points sit sigma²·d from their own center on average, which bounds the optimum
+    std::printf("100k x 16, 50 blobs; inertia/N of the generating centers ~ %.0f\n", d * sigma * sigma);
+
+    for (int init = 0; init < 3; ++init) {
+        for (uint64_t seed = 1; seed <= 3; ++seed) {
+
+            aicpp::KMeansClusterer km(50, 300, aicpp::KMeansClusterer::Init(init));
+            km.set_seed(seed);
+            {
+                QuietCout quiet;
+                km.train(data);
+            }
+            std::printf("%-10s seed %llu | %3d iterations | inertia/N %.3f\n", names[init],
+                        static_cast<unsigned long long>(seed), km.iterations(), km.inertia() / data.rows());
+        }
+    }
+}
+
+// K-Means assignment: distance evaluations of Hamerly and Elkan against Lloyd, whose
+// clusters they must reproduce exactly
+void bench_assignment() {
+
+    print_header("assignment");
+
+    const char* names[] = {"Lloyd", "Hamerly", "Elkan"};
+
+    for (bool blobs : {false, true}) {
+
+        // Unstructured: one N(0, 4) cloud; blobs: 100 centers uniform in ±10
+        Dataset data = blobs ? gaussian_blobs(50000, 32, 100, 10.0, false, 2.0, 11)
+                             : gaussian_blobs(50000, 32, 1, 0.0, false, 2.0, 11);
+
+        for (int k : {64, 128}) {
+
+            size_t lloyd_evaluations = 0;
+            std::vector<int> lloyd_ids;
+            std::vector<std::vector<real>> lloyd_centroids;
+
+            for (int a = 0; a < 3; ++a) {
+
+                aicpp::KMeansClusterer km(k, 100, aicpp::KMeansClusterer::Init::KMeansPlusPlus,
+                                          aicpp::KMeansClusterer::Algorithm(a));
+                km.set_seed(5);
+
+                Clock::time_point start = Clock::now();
+                {
+                    QuietCout quiet;
+                    km.train(data);
+                }
+                const double train = seconds_since(start);
+
+                bool identical = true;
+                if (a == 0) {
+                    lloyd_evaluations = km.distance_evaluations();
+                    lloyd_ids = data.cluster_ids();
+                    lloyd_centroids = km.get_centroids();
+                } else {
+                    identical = data.cluster_ids() == lloyd_ids && km.get_centroids() == lloyd_centroids;
+                }
+
+                std::printf("%-12s K = %3d | %-7s | %11zu distances (%5.1fx fewer) | %6.2f s | %s\n",
+                            blobs ? "100 blobs" : "unstructured", k, names[a], km.distance_evaluations(),
+                            static_cast<double>(lloyd_evaluations) / km.distance_evaluations(), train,
+                            identical ? "identical to Lloyd" : "DIFFERS from Lloyd");
+            }
+        }
+    }
+}
+
+struct Benchmark {
+    const char* name;
+    const char* description;
+    void (*run)();
+};
+
+const Benchmark kBenchmarks[] = {
+    {"kmeans",   "K-Means, 1M x 16, K = 32, 25 Lloyd iterations", bench_kmeans},
+    {"logistic", "Logistic Regression, 1M x 32, 50 gradient-descent epochs", bench_logistic},
+    {"seeding",  "K-Means seeding (random, k-means++, k-means||), 100k x 16, K = 50", bench_seeding},
+    {"assignment", "K-Means Lloyd / Hamerly / Elkan distance counts, 50k x 32, K = 64 and 128", bench_assignment},
+};
+
+void usage() {
+    std::printf("Usage: ai_lab_bench <benchmark>...\n\nBenchmarks:\n");
+    for (const Benchmark& b : kBenchmarks) std::printf("  %-12s %s\n", b.name, b.description);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    // Peak RSS is per process, so run one benchmark per invocation when comparing memory
+    for (int i = 1; i < argc; ++i) {
+
+        const Benchmark* found = nullptr;
+        for (const Benchmark& b : kBenchmarks) {
+            if (std::strcmp(argv[i], b.name) == 0) found = &b;
+        }
+        if (!found) {
+            std::printf("Unknown benchmark: %s\n\n", argv[i]);
+            usage();
+            return 1;
+        }
+        found->run();
+    }
+    return 0;
+}
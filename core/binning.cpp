@@ -0,0 +1,136 @@
+#include "core/binning.h"
+#include "core/thread_pool.h"
+#include <algorithm>
+
+namespace aicpp {
+
+namespace {
+
+// Rows binned per chunk
+const size_t kMinBinRows = size_t(1) << 14;
+
+} // namespace
+
+void BinnedMatrix::build(const Dataset& data, int max_bins, Layout layout) {
+
+    max_bins = std::max(2, std::min(max_bins, kMaxBins));
+    rows_ = data.rows();
+    cols_ = data.cols();
+    layout_ = layout;
+    cuts_.assign(cols_, {});
+    codes_.resize(rows_ * cols_);
+
+    const size_t sample = std::min(rows_, kSampleRows);
+    const size_t limit = static_cast<size_t>(max_bins);
+
+    // Features binned one bin per value, and the smallest value (the bottom of bin 0)
+    std::vector<char> exact(cols_, 0);
+    std::vector<real> lowest(cols_, 0);
+
+    // Cuts of feature f from the sample; with full_scan the distinct values are counted
+    // over every row, stopping once there are too many of them
+    auto find_cuts = [&](size_t f, bool full_scan, std::vector<real>& values) {
+
+        values.resize(sample);
+        for (size_t i = 0; i < sample; ++i) values[i] = data(i * rows_ / sample, f);
+        std::sort(values.begin(), values.end());
+
+        std::vector<real> distinct;
+        for (size_t i = 0; i < sample && distinct.size() <= limit; ++i) {
+            if (values[i] != values[i]) continue;  // NaN takes the last bin
+            if (distinct.empty() || values[i] != distinct.back()) distinct.push_back(values[i]);
+        }
+        for (size_t r = 0; full_scan && r < rows_ && distinct.size() <= limit; ++r) {
+            const real x = data(r, f);
+            auto at = std::lower_bound(distinct.begin(), distinct.end(), x);
+            if (x == x && (at == distinct.end() || *at != x)) distinct.insert(at, x);
+        }
+
+        std::vector<real>& cuts = cuts_[f];
+        cuts.clear();
+        exact[f] = distinct.size() <= limit;
+
+        if (exact[f]) {
+            // One bin per value; the cuts are every value but the smallest
+            if (!distinct.empty()) {
+                lowest[f] = distinct[0];
+                cuts.assign(distinct.begin() + 1, distinct.end());
+            }
+        } else {
+            // Equal-frequency cuts; repeated values collapse into one bin
+            for (int b = 1; b < max_bins; ++b) {
+                real cut = values[b * sample / max_bins];
+                if (cut > values[0] && (cuts.empty() || cut > cuts.back())) cuts.push_back(cut);
+            }
+        }
+    };
+
+    // Codes of the given features, in row blocks so that row-major input is read
+    // sequentially. A value in a one-value bin that differs from that value is one
+    // the sample missed; such features are flagged.
+    const size_t row_stride = layout == Layout::RowMajor ? cols_ : 1;
+    const size_t col_stride = layout == Layout::RowMajor ? 1 : rows_;
+
+    auto encode = [&](const std::vector<size_t>& features) {
+
+        std::vector<std::vector<char>> missed(parallel_chunks(rows_, kMinBinRows), std::vector<char>(cols_, 0));
+        parallel_for(rows_, kMinBinRows, [&](size_t chunk, size_t begin, size_t end) {
+            char* miss = missed[chunk].data();
+            for (size_t r = begin; r < end; ++r) {
+                for (size_t f : features) {
+                    const real x = data(r, f);
+                    const uint8_t b = bin_of(f, x);
+                    codes_[r * row_stride + f * col_stride] = b;
+                    if (exact[f] && x == x && x != (b ? cuts_[f][b - 1] : lowest[f])) miss[f] = 1;
+                }
+            }
+        });
+
+        std::vector<size_t> flagged;
+        for (size_t f = 0; f < cols_; ++f) {
+            for (const std::vector<char>& m : missed) {
+                if (m[f]) {
+                    flagged.push_back(f);
+                    break;
+                }
+            }
+        }
+        return flagged;
+    };
+
+    parallel_for(cols_, 1, [&](size_t, size_t begin, size_t end) {
+        std::vector<real> values;
+        for (size_t f = begin; f < end; ++f) find_cuts(f, false, values);
+    });
+
+    std::vector<size_t> all(cols_);
+    for (size_t f = 0; f < cols_; ++f) all[f] = f;
+    std::vector<size_t> missed = encode(all);
+
+    // Rare values the sample skipped: recount those features over every row and re-bin them
+    if (!missed.empty()) {
+        parallel_for(missed.size(), 1, [&](size_t, size_t begin, size_t end) {
+            std::vector<real> values;
+            for (size_t i = begin; i < end; ++i) find_cuts(missed[i], true, values);
+        });
+        encode(missed);
+    }
+}
+
+uint8_t BinnedMatrix::bin_of(size_t feature, real x) const {
+
+    // Branch-free upper_bound: the number of cuts c with !(x < c), so NaN lands in the last bin
+    const std::vector<real>& cuts = cuts_[feature];
+    size_t n = cuts.size();
+    if (n == 0) return 0;
+
+    const real* base = cuts.data();
+    while (n > 1) {
+        const size_t half = n / 2;
+        base = (x < base[half - 1]) ? base : base + half;
+        n -= half;
+    }
+    return static_cast<uint8_t>((base - cuts.data()) + !(x < *base));
+}
+
+} // namespace aicpp
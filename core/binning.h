@@ -0,0 +1,66 @@
+#ifndef AI_LAB_BINNING_H
+#define AI_LAB_BINNING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/data_types.h"
+#include "core/dataset.h"
+
+namespace aicpp {
+
+/**
+ * @brief Features quantised to at most 256 quantile bins, one uint8_t column per feature.
+ * * Each feature gets sorted cut points c_0 < c_1 < ...; a value's bin is the number
+ * of cuts not above it. Bins 0..b therefore hold exactly the values x < c_b, so a
+ * split found on bin codes is the ordinary threshold split x < threshold(f, b) on raw
+ * features. A feature with at most max_bins distinct values over all rows gets one
+ * bin per value and its cuts are those values, like the exact splitter's thresholds.
+ * * Codes are stored column-major (one contiguous column per feature) or row-major
+ * (all codes of a row together), whichever the consumer reads; the row-major form
+ * suits histograms over a permuted subset of rows, one cache line per row.
+ */
+class BinnedMatrix {
+public:
+
+    static constexpr int kMaxBins = 256;
+
+    // Quantile cuts are taken from an evenly spaced sample of at most kSampleRows rows
+    // per feature; distinct values are counted over every row
+    static constexpr size_t kSampleRows = size_t(1) << 18;
+
+    // Computes the cuts from data (either layout) and bins every row, in parallel
+    void build(const Dataset& data, int max_bins = kMaxBins, Layout layout = Layout::ColMajor);
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+    // Number of bins of a feature (number of cuts + 1)
+    int bins(size_t feature) const { return static_cast<int>(cuts_[feature].size()) + 1; }
+
+    Layout layout() const { return layout_; }
+
+    // rows() bin codes of one feature; requires Layout::ColMajor
+    const uint8_t* column(size_t feature) const { return codes_.data() + feature * rows_; }
+
+    // cols() bin codes of one row; requires Layout::RowMajor
+    const uint8_t* row(size_t r) const { return codes_.data() + r * cols_; }
+
+    // Raw-feature threshold equivalent to "bin <= b"; valid for b < bins(feature) - 1
+    real threshold(size_t feature, int bin) const { return cuts_[feature][bin]; }
+
+    // Bin of a raw value, e.g. for rows that were not part of build()
+    uint8_t bin_of(size_t feature, real x) const;
+
+private:
+
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    Layout layout_ = Layout::ColMajor;
+    std::vector<std::vector<real>> cuts_;
+    std::vector<uint8_t> codes_;  // rows_ x cols_ in layout_
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_BINNING_H
@@ -11,10 +11,21 @@
  */
 
 namespace aicpp {
+
+/**
+ * @brief Scalar type for features and model parameters.
+ * * Configure with -DAICPP_USE_FLOAT=ON for single precision (half the memory
+ * traffic, twice the SIMD width); accumulators such as losses and sums stay double.
+ */
+#ifdef AICPP_USE_FLOAT
+    using real = float;
+#else
+    using real = double;
+#endif
     
     struct DataPoint {
     
-    std::vector<double> features; 
+    std::vector<real> features; 
 
     // For supervised learning (Decision Tree, Logistic Regression)
     int label = -1;
@@ -25,7 +36,7 @@ namespace aicpp {
 
     // Constructor for easy initialization
     DataPoint() = default;
-    DataPoint(const std::vector<double>& f, int lbl = -1)
+    DataPoint(const std::vector<real>& f, int lbl = -1)
         : features(f), label(lbl) {}
 };
 } // namespace aicpp
@@ -0,0 +1,210 @@
+#include "core/dataset.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace aicpp {
+
+void Dataset::AlignedDelete::operator()(real* p) const {
+    ::operator delete[](p, std::align_val_t(kAlignment));
+}
+
+void Dataset::allocate(size_t count) {
+    real* p = static_cast<real*>(::operator new[](std::max<size_t>(count, 1) * sizeof(real),
+                                                      std::align_val_t(kAlignment)));
+    buffer_.reset(p);
+    capacity_ = count;
+    data_ = p;
+}
+
+Dataset::Dataset(size_t rows, size_t cols, Layout layout)
+    : rows_(rows), cols_(cols), ld_(layout == Layout::RowMajor ? cols : rows),
+      layout_(layout), cluster_ids_(rows, -1) {
+
+    allocate(rows * cols);
+    std::fill(buffer_.get(), buffer_.get() + rows * cols, 0.0);
+}
+
+Dataset::Dataset(const Dataset& other)
+    : rows_(other.rows_), cols_(other.cols_), ld_(other.ld_), layout_(other.layout_),
+      data_(other.data_), label_store_(other.label_store_), labels_(other.labels_),
+      cluster_ids_(other.cluster_ids_), owner_(other.owner_) {
+
+    if (other.buffer_) {
+        size_t count = (layout_ == Layout::RowMajor ? rows_ : cols_) * ld_;
+        allocate(count);
+        std::memcpy(buffer_.get(), other.data_, count * sizeof(real));
+    }
+    if (!other.label_store_.empty()) labels_ = label_store_.data();
+}
+
+Dataset& Dataset::operator=(const Dataset& other) {
+    if (this != &other) {
+        Dataset copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Dataset Dataset::from_points(const std::vector<DataPoint>& points) {
+
+    size_t cols = points.empty() ? 0 : points[0].features.size();
+    Dataset ds(points.size(), cols);
+
+    bool labelled = std::any_of(points.begin(), points.end(),
+                                [](const DataPoint& p) { return p.label != -1; });
+    real* labels = labelled ? ds.mutable_labels() : nullptr;
+
+    for (size_t r = 0; r < points.size(); ++r) {
+        if (points[r].features.size() != cols) {
+            throw std::runtime_error("All data points must have the same number of features.");
+        }
+        std::copy(points[r].features.begin(), points[r].features.end(), ds.row_ptr(r));
+        if (labels) labels[r] = points[r].label;
+        ds.cluster_ids_[r] = points[r].cluster_id;
+    }
+    return ds;
+}
+
+Dataset Dataset::from_rows(const std::vector<std::vector<real>>& rows,
+                           const std::vector<real>& labels) {
+
+    size_t cols = rows.empty() ? 0 : rows[0].size();
+    Dataset ds(rows.size(), cols);
+
+    for (size_t r = 0; r < rows.size(); ++r) {
+        if (rows[r].size() != cols) {
+            throw std::runtime_error("All rows must have the same number of features.");
+        }
+        std::copy(rows[r].begin(), rows[r].end(), ds.row_ptr(r));
+    }
+
+    if (!labels.empty()) {
+        if (labels.size() != rows.size()) throw std::runtime_error("Label count does not match row count.");
+        ds.set_labels(labels);
+    }
+    return ds;
+}
+
+std::vector<DataPoint> Dataset::to_points() const {
+
+    std::vector<DataPoint> points(rows_);
+    for (size_t r = 0; r < rows_; ++r) {
+        points[r].features = row(r).to_vector();
+        if (labels_) points[r].label = static_cast<int>(labels_[r]);
+        points[r].cluster_id = cluster_ids_[r];
+    }
+    return points;
+}
+
+std::vector<std::vector<real>> Dataset::to_rows() const {
+
+    std::vector<std::vector<real>> out(rows_);
+    for (size_t r = 0; r < rows_; ++r) out[r] = row(r).to_vector();
+    return out;
+}
+
+Dataset Dataset::view(const real* features, size_t rows, size_t cols, Layout layout,
+                      const real* labels, std::shared_ptr<const void> owner,
+                      size_t leading_dim) {
+    Dataset ds;
+    ds.rows_ = rows;
+    ds.cols_ = cols;
+    ds.ld_ = leading_dim ? leading_dim : (layout == Layout::RowMajor ? cols : rows);
+    ds.layout_ = layout;
+    ds.data_ = features;
+    ds.labels_ = labels;
+    ds.cluster_ids_.assign(rows, -1);
+    ds.owner_ = std::move(owner);
+    return ds;
+}
+
+Dataset Dataset::as_row_major() const {
+
+    if (layout_ == Layout::ColMajor) return to_layout(Layout::RowMajor);
+
+    Dataset v = view(data_, rows_, cols_, layout_, labels_, owner_, ld_);
+    v.cluster_ids_ = cluster_ids_;
+    return v;
+}
+
+Dataset Dataset::to_layout(Layout layout) const {
+
+    Dataset out(rows_, cols_, layout);
+
+    // outer x inner is the source shape in memory order (rows of a RowMajor source)
+    size_t outer = (layout_ == Layout::RowMajor) ? rows_ : cols_;
+    size_t inner = (layout_ == Layout::RowMajor) ? cols_ : rows_;
+    real* dst = out.buffer_.get();
+
+    if (layout == layout_) {
+        for (size_t i = 0; i < outer; ++i)
+            std::memcpy(dst + i * inner, data_ + i * ld_, inner * sizeof(real));
+    } else {
+        // Blocked transpose keeps both sides cache-resident
+        const size_t block = 32;
+        for (size_t i0 = 0; i0 < outer; i0 += block) {
+            for (size_t j0 = 0; j0 < inner; j0 += block) {
+                size_t i1 = std::min(i0 + block, outer), j1 = std::min(j0 + block, inner);
+                for (size_t i = i0; i < i1; ++i)
+                    for (size_t j = j0; j < j1; ++j) dst[j * outer + i] = data_[i * ld_ + j];
+            }
+        }
+    }
+
+    if (labels_) out.set_labels(std::vector<real>(labels_, labels_ + rows_));
+    out.cluster_ids_ = cluster_ids_;
+    return out;
+}
+
+void Dataset::resize(size_t rows, size_t cols) {
+
+    if (!buffer_ && data_) throw std::runtime_error("Cannot resize a read-only dataset view.");
+
+    if (!buffer_ || rows * cols > capacity_) allocate(rows * cols);
+    rows_ = rows;
+    cols_ = cols;
+    ld_ = cols;
+    layout_ = Layout::RowMajor;
+
+    if (labels_) {
+        label_store_.resize(rows);
+        labels_ = label_store_.data();
+    }
+    cluster_ids_.assign(rows, -1);
+}
+
+RowView Dataset::row(size_t r) const {
+    return layout_ == Layout::RowMajor ? RowView(data_ + r * ld_, cols_, 1)
+                                       : RowView(data_ + r, cols_, ld_);
+}
+
+ColumnView Dataset::col(size_t c) const {
+    return layout_ == Layout::RowMajor ? ColumnView(data_ + c, rows_, ld_)
+                                       : ColumnView(data_ + c * ld_, rows_, 1);
+}
+
+real* Dataset::mutable_data() {
+    if (!buffer_) throw std::runtime_error("Dataset view is read-only.");
+    return buffer_.get();
+}
+
+void Dataset::set_labels(std::vector<real> labels) {
+    if (labels.size() != rows_) throw std::runtime_error("Label count does not match row count.");
+    label_store_ = std::move(labels);
+    labels_ = label_store_.data();
+}
+
+real* Dataset::mutable_labels() {
+    if (labels_ && label_store_.empty() && rows_ > 0) {
+        throw std::runtime_error("Dataset view labels are read-only.");
+    }
+    if (!labels_) {
+        label_store_.assign(rows_, 0.0);
+        labels_ = label_store_.data();
+    }
+    return label_store_.data();
+}
+
+} // namespace aicpp
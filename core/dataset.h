@@ -0,0 +1,154 @@
+#ifndef AI_LAB_DATASET_H
+#define AI_LAB_DATASET_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "core/data_types.h"
+
+namespace aicpp {
+
+enum class Layout { RowMajor, ColMajor };
+
+/**
+ * @brief Non-owning strided view of one row or one column of a Dataset.
+ */
+template <typename T>
+class StridedView {
+public:
+    StridedView(const T* data, size_t size, size_t stride)
+        : data_(data), size_(size), stride_(stride) {}
+
+    const T& operator[](size_t i) const { return data_[i * stride_]; }
+    size_t size() const { return size_; }
+    size_t stride() const { return stride_; }
+    bool contiguous() const { return stride_ == 1; }
+    const T* data() const { return data_; }
+
+    std::vector<T> to_vector() const {
+        std::vector<T> out(size_);
+        for (size_t i = 0; i < size_; ++i) out[i] = (*this)[i];
+        return out;
+    }
+
+private:
+    const T* data_;
+    size_t size_;
+    size_t stride_;
+};
+
+using RowView = StridedView<real>;
+using ColumnView = StridedView<real>;
+
+/**
+ * @brief Dense dataset: one 64-byte aligned feature buffer (row- or column-major)
+ * plus separate label and cluster_id arrays.
+ * * A Dataset either owns its features or is a read-only view over external
+ * memory (e.g. a memory-mapped cache); `owner` keeps that memory alive.
+ * Copies of an owning Dataset are deep; copies of a view are views.
+ */
+class Dataset {
+public:
+
+    static constexpr size_t kAlignment = 64;
+
+    Dataset() = default;
+
+    // Zero-initialised rows x cols features, no labels
+    Dataset(size_t rows, size_t cols, Layout layout = Layout::RowMajor);
+
+    Dataset(const Dataset& other);
+    Dataset& operator=(const Dataset& other);
+    Dataset(Dataset&&) noexcept = default;
+    Dataset& operator=(Dataset&&) noexcept = default;
+
+    // --- Adapters for the existing containers ---
+    static Dataset from_points(const std::vector<DataPoint>& points);
+    static Dataset from_rows(const std::vector<std::vector<real>>& rows,
+                             const std::vector<real>& labels = {});
+    std::vector<DataPoint> to_points() const;
+    std::vector<std::vector<real>> to_rows() const;
+
+    // Read-only view over external memory; labels may be null. leading_dim is the
+    // distance between consecutive rows (RowMajor) or columns (ColMajor), 0 = packed.
+    static Dataset view(const real* features, size_t rows, size_t cols, Layout layout,
+                        const real* labels = nullptr,
+                        std::shared_ptr<const void> owner = nullptr,
+                        size_t leading_dim = 0);
+
+    // Row-major version of this dataset: a view of *this when already row-major
+    // (valid while *this lives), otherwise a transposed owning copy
+    Dataset as_row_major() const;
+    Dataset to_layout(Layout layout) const;
+
+    // Reshapes an owning row-major dataset, reusing the buffer when it is large enough.
+    // Contents are unspecified afterwards; labels (if present) and cluster ids are resized.
+    void resize(size_t rows, size_t cols);
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    bool empty() const { return rows_ == 0; }
+    Layout layout() const { return layout_; }
+    bool is_view() const { return !buffer_; }
+
+    // --- Feature access ---
+    real operator()(size_t r, size_t c) const { return data_[index(r, c)]; }
+    real& at(size_t r, size_t c) { return mutable_data()[index(r, c)]; }
+
+    RowView row(size_t r) const;
+    ColumnView col(size_t c) const;
+
+    // Contiguous row pointer; requires Layout::RowMajor
+    const real* row_ptr(size_t r) const { return data_ + r * ld_; }
+    real* row_ptr(size_t r) { return mutable_data() + r * ld_; }
+
+    // Contiguous column pointer; requires Layout::ColMajor
+    const real* col_ptr(size_t c) const { return data_ + c * ld_; }
+
+    size_t leading_dim() const { return ld_; }
+
+    const real* data() const { return data_; }
+    real* mutable_data();
+
+    // --- Labels ---
+    bool has_labels() const { return labels_ != nullptr; }
+    const real* labels() const { return labels_; }
+    real label(size_t r) const { return labels_[r]; }
+    void set_labels(std::vector<real> labels);
+    real* mutable_labels();  // allocates zeroed labels on first use
+
+    // --- Cluster assignments (always owned, -1 = unassigned) ---
+    std::vector<int>& cluster_ids() { return cluster_ids_; }
+    const std::vector<int>& cluster_ids() const { return cluster_ids_; }
+
+private:
+
+    struct AlignedDelete {
+        void operator()(real* p) const;
+    };
+
+    size_t index(size_t r, size_t c) const {
+        return layout_ == Layout::RowMajor ? r * ld_ + c : c * ld_ + r;
+    }
+
+    void allocate(size_t count);
+
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t ld_ = 0;
+    Layout layout_ = Layout::RowMajor;
+
+    std::unique_ptr<real[], AlignedDelete> buffer_;  // null for views
+    size_t capacity_ = 0;
+    const real* data_ = nullptr;
+
+    std::vector<real> label_store_;
+    const real* labels_ = nullptr;
+
+    std::vector<int> cluster_ids_;
+    std::shared_ptr<const void> owner_;
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_DATASET_H
@@ -0,0 +1,143 @@
+#include "core/distance.h"
+#include "core/simd.h"
+#include <algorithm>
+#include <limits>
+
+namespace aicpp {
+
+namespace {
+
+// Rows per GEMM tile, and the most centroids per block; a block targets about
+// kBlockBytes so that it stays in L2 while a tile of rows streams past it
+const size_t kRowTile = 32;
+const size_t kMaxColBlock = 128;
+const size_t kBlockBytes = 96 * 1024;
+
+// Near-ties kept per row for exact re-measurement; rows with more fall back to a full exact scan
+const size_t kMaxCandidates = 8;
+
+} // namespace
+
+void CentroidSet::assign(const std::vector<std::vector<real>>& centroids) {
+
+    k_ = centroids.size();
+    dim_ = k_ ? centroids[0].size() : 0;
+    original_.resize(k_ * dim_);
+    packed_.resize(k_ * dim_);
+    norms_.resize(k_);
+    max_norm_ = 0.0;
+
+    std::vector<double> mean(dim_, 0.0);
+    for (size_t c = 0; c < k_; ++c) {
+        std::copy(centroids[c].begin(), centroids[c].end(), original_.begin() + c * dim_);
+        simd::multiply_accumulate(1.0, centroids[c].data(), mean.data(), dim_);
+    }
+    center_.resize(dim_);
+    for (size_t j = 0; j < dim_; ++j) center_[j] = static_cast<real>(mean[j] / std::max<size_t>(k_, 1));
+
+    for (size_t c = 0; c < k_; ++c) {
+        real* shifted = packed_.data() + c * dim_;
+        for (size_t j = 0; j < dim_; ++j) shifted[j] = centroids[c][j] - center_[j];
+        norms_[c] = simd::dot(shifted, shifted, dim_);
+        max_norm_ = std::max(max_norm_, static_cast<double>(norms_[c]));
+    }
+
+    col_block_ = std::min(kMaxColBlock, std::max<size_t>(8, kBlockBytes / std::max<size_t>(1, dim_ * sizeof(real))));
+
+    // Covers the rounding of the shift, the norms and dot products in the expansion
+    // and of the exact re-measurement, each at most a few D·ε of ‖x‖² + ‖c‖²
+    tolerance_ = 10.0 * std::numeric_limits<real>::epsilon() * static_cast<double>(dim_ + 16);
+}
+
+void CentroidSet::nearest(const real* X, size_t n, size_t ld, int* labels, double* distances) const {
+
+    thread_local std::vector<real> shifted;
+    shifted.resize(kRowTile * dim_);
+
+    real dots[kRowTile * kMaxColBlock];
+    double row_norm[kRowTile], best_approx[kRowTile], margin[kRowTile];
+    size_t candidates[kRowTile][kMaxCandidates];
+    double candidate_approx[kRowTile][kMaxCandidates];
+    size_t num_candidates[kRowTile];
+    bool overflow[kRowTile];
+
+    for (size_t r0 = 0; r0 < n; r0 += kRowTile) {
+
+        const size_t m = std::min(kRowTile, n - r0);
+        const real* tile = X + r0 * ld;
+
+        for (size_t i = 0; i < m; ++i) {
+            const real* x = tile + i * ld;
+            real* xs = shifted.data() + i * dim_;
+            for (size_t j = 0; j < dim_; ++j) xs[j] = x[j] - center_[j];
+            row_norm[i] = simd::dot(xs, xs, dim_);
+            margin[i] = tolerance_ * (row_norm[i] + max_norm_);
+            best_approx[i] = std::numeric_limits<double>::max();
+            num_candidates[i] = 0;
+            overflow[i] = false;
+        }
+
+        // Expanded distances block by block, keeping every centroid within the margin of the best so far
+        for (size_t c0 = 0; c0 < k_; c0 += col_block_) {
+
+            const size_t nb = std::min(col_block_, k_ - c0);
+            simd::gemm_nt(shifted.data(), m, dim_, packed_.data() + c0 * dim_, nb, dim_, dim_, dots, nb);
+
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < nb; ++j) {
+
+                    const double d = row_norm[i] + norms_[c0 + j] - 2.0 * static_cast<double>(dots[i * nb + j]);
+                    if (d > best_approx[i] + margin[i]) continue;
+
+                    if (d < best_approx[i]) {
+                        best_approx[i] = d;
+                        size_t kept = 0;
+                        for (size_t q = 0; q < num_candidates[i]; ++q) {
+                            if (candidate_approx[i][q] <= d + margin[i]) {
+                                candidates[i][kept] = candidates[i][q];
+                                candidate_approx[i][kept++] = candidate_approx[i][q];
+                            }
+                        }
+                        num_candidates[i] = kept;
+                    }
+
+                    if (num_candidates[i] == kMaxCandidates) {
+                        overflow[i] = true;
+                        continue;
+                    }
+                    candidates[i][num_candidates[i]] = c0 + j;
+                    candidate_approx[i][num_candidates[i]++] = d;
+                }
+            }
+        }
+
+        // Exact re-measurement in ascending index order, so ties go to the lowest index
+        for (size_t i = 0; i < m; ++i) {
+
+            const real* x = tile + i * ld;
+            double best = std::numeric_limits<double>::max();
+            int best_id = -1;
+
+            auto measure = [&](size_t c) {
+                double d = simd::squared_l2(x, centroid(c), dim_);
+                if (d < best) {
+                    best = d;
+                    best_id = static_cast<int>(c);
+                }
+            };
+
+            if (overflow[i]) {
+                for (size_t c = 0; c < k_; ++c) measure(c);
+            } else {
+                for (size_t q = 0; q < num_candidates[i]; ++q) {
+                    if (candidate_approx[i][q] <= best_approx[i] + margin[i]) measure(candidates[i][q]);
+                }
+            }
+
+            labels[r0 + i] = best_id;
+            if (distances) distances[r0 + i] = best;
+        }
+    }
+}
+
+} // namespace aicpp
@@ -0,0 +1,52 @@
+#ifndef AI_LAB_DISTANCE_H
+#define AI_LAB_DISTANCE_H
+
+#include <cstddef>
+#include <vector>
+#include "core/data_types.h"
+
+namespace aicpp {
+
+/**
+ * @brief Centroids packed for blocked nearest-centroid queries.
+ * * Squared distances are expanded as ‖x‖² − 2x·c + ‖c‖², so a tile of rows
+ * against a block of centroids is one cache-blocked A·Cᵀ product (simd::gemm_nt)
+ * plus precomputed norms, without a sqrt. Both sides are shifted by the centroid
+ * mean first, which keeps the norms, and so the cancellation error, small for data
+ * far from the origin. Every centroid within that rounding bound of the best one is
+ * re-measured with simd::squared_l2. The result is therefore identical to an
+ * exhaustive squared_l2 scan that keeps the lowest index on ties.
+ */
+class CentroidSet {
+public:
+
+    // Packs the K x D centroids and their norms; call again after every update
+    void assign(const std::vector<std::vector<real>>& centroids);
+
+    size_t size() const { return k_; }
+    size_t dim() const { return dim_; }
+    const real* centroid(size_t c) const { return original_.data() + c * dim_; }
+
+    /**
+     * @brief For rows [0, n) of the row-major block X (row stride ld), writes the
+     * nearest centroid to labels[i] and, when distances is non-null, its squared
+     * distance. Uses thread-local scratch; safe to call concurrently.
+     */
+    void nearest(const real* X, size_t n, size_t ld, int* labels, double* distances) const;
+
+private:
+
+    size_t k_ = 0;
+    size_t dim_ = 0;
+    size_t col_block_ = 0;       // centroids per GEMM block
+    double tolerance_ = 0.0;     // expansion error bound relative to ‖x‖² + ‖c‖²
+    double max_norm_ = 0.0;
+    std::vector<real> original_; // K x D, row-major
+    std::vector<real> center_;   // mean of the centroids
+    std::vector<real> packed_;   // K x D centroids minus center_
+    std::vector<real> norms_;    // ‖c − center‖²
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_DISTANCE_H
@@ -0,0 +1,110 @@
+#include "core/linalg.h"
+#include <algorithm>
+#include <cmath>
+
+namespace aicpp {
+
+bool cholesky_factor(std::vector<double>& a, size_t n, double* condition) {
+
+    double min_pivot = 0.0, max_pivot = 0.0;
+
+    for (size_t j = 0; j < n; ++j) {
+
+        double* row_j = a.data() + j * n;
+
+        double d = row_j[j];
+        for (size_t k = 0; k < j; ++k) d -= row_j[k] * row_j[k];
+        if (!(d > 0.0)) return false;
+
+        double pivot = std::sqrt(d);
+        row_j[j] = pivot;
+        min_pivot = (j == 0) ? pivot : std::min(min_pivot, pivot);
+        max_pivot = std::max(max_pivot, pivot);
+
+        for (size_t i = j + 1; i < n; ++i) {
+            double* row_i = a.data() + i * n;
+            double s = row_i[j];
+            for (size_t k = 0; k < j; ++k) s -= row_i[k] * row_j[k];
+            row_i[j] = s / pivot;
+        }
+    }
+
+    if (condition) {
+        double ratio = (n == 0) ? 1.0 : max_pivot / min_pivot;
+        *condition = ratio * ratio;
+    }
+    return true;
+}
+
+void cholesky_solve(const std::vector<double>& l, size_t n, std::vector<double>& b) {
+
+    // Forward: L z = b
+    for (size_t i = 0; i < n; ++i) {
+        double s = b[i];
+        for (size_t k = 0; k < i; ++k) s -= l[i * n + k] * b[k];
+        b[i] = s / l[i * n + i];
+    }
+
+    // Backward: Lᵀ x = z
+    for (size_t i = n; i-- > 0; ) {
+        double s = b[i];
+        for (size_t k = i + 1; k < n; ++k) s -= l[k * n + i] * b[k];
+        b[i] = s / l[i * n + i];
+    }
+}
+
+IncrementalQR::IncrementalQR(size_t p)
+    : p_(p), r_(p * p, 0.0), qty_(p, 0.0), row_(p, 0.0) {}
+
+void IncrementalQR::add_row(const double* x, double y) {
+
+    std::copy(x, x + p_, row_.begin());
+
+    // Rotate the new row into R, eliminating one entry per pivot
+    for (size_t j = 0; j < p_; ++j) {
+
+        double xj = row_[j];
+        if (xj == 0.0) continue;
+
+        double* rj = r_.data() + j * p_;
+        double rjj = rj[j];
+        double h = std::hypot(rjj, xj);
+        double c = rjj / h, s = xj / h;
+
+        rj[j] = h;
+        for (size_t k = j + 1; k < p_; ++k) {
+            double a = rj[k], b = row_[k];
+            rj[k] = c * a + s * b;
+            row_[k] = c * b - s * a;
+        }
+
+        double a = qty_[j];
+        qty_[j] = c * a + s * y;
+        y = c * y - s * a;
+    }
+}
+
+void IncrementalQR::merge(const IncrementalQR& other) {
+    for (size_t i = 0; i < other.p_; ++i) add_row(other.r_.data() + i * p_, other.qty_[i]);
+}
+
+std::vector<double> IncrementalQR::solve(double rank_tol) const {
+
+    double max_pivot = 0.0;
+    for (size_t j = 0; j < p_; ++j) max_pivot = std::max(max_pivot, std::fabs(r_[j * p_ + j]));
+    const double cutoff = rank_tol * max_pivot;
+
+    std::vector<double> w(p_, 0.0);
+    for (size_t i = p_; i-- > 0; ) {
+
+        double rii = r_[i * p_ + i];
+        if (std::fabs(rii) <= cutoff) continue;
+
+        double s = qty_[i];
+        for (size_t k = i + 1; k < p_; ++k) s -= r_[i * p_ + k] * w[k];
+        w[i] = s / rii;
+    }
+    return w;
+}
+
+} // namespace aicpp
@@ -0,0 +1,55 @@
+#ifndef AI_LAB_LINALG_H
+#define AI_LAB_LINALG_H
+
+#include <cstddef>
+#include <vector>
+
+namespace aicpp {
+
+/**
+ * @brief In-place Cholesky factorisation of the symmetric positive definite n x n
+ * row-major matrix `a` (only the lower triangle is read). On success the lower
+ * triangle holds L with a = L Lᵀ.
+ * * Returns false when a pivot is not positive. `condition`, if given, receives
+ * the estimate (max L_ii / min L_ii)², a cheap lower bound on cond(a).
+ */
+bool cholesky_factor(std::vector<double>& a, size_t n, double* condition = nullptr);
+
+// Solves L Lᵀ x = b in place, given the factor produced by cholesky_factor
+void cholesky_solve(const std::vector<double>& l, size_t n, std::vector<double>& b);
+
+/**
+ * @brief Least-squares solver that consumes one row at a time with Givens rotations.
+ * * Keeps only the p x p triangular factor R and Qᵀy, so a single pass over the
+ * data costs O(N p²) time and O(p²) memory. Partial factors from separate
+ * chunks of rows can be merged, which makes the pass parallel. Works on the
+ * design matrix itself, so it is accurate even when XᵀX is ill-conditioned.
+ */
+class IncrementalQR {
+public:
+
+    explicit IncrementalQR(size_t p = 0);
+
+    size_t size() const { return p_; }
+
+    // Adds the equation x·w = y (x has size() entries)
+    void add_row(const double* x, double y);
+
+    // Folds the rows absorbed by another factor of the same size into this one
+    void merge(const IncrementalQR& other);
+
+    // Solves R w = Qᵀy. Columns whose pivot is below rank_tol * max pivot are
+    // treated as linearly dependent and get weight 0 (basic solution).
+    std::vector<double> solve(double rank_tol = 1e-10) const;
+
+private:
+
+    size_t p_;
+    std::vector<double> r_;    // p x p upper triangular, row-major
+    std::vector<double> qty_;  // Qᵀy
+    std::vector<double> row_;  // scratch for add_row
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_LINALG_H
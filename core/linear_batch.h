@@ -0,0 +1,47 @@
+#ifndef AI_LAB_LINEAR_BATCH_H
+#define AI_LAB_LINEAR_BATCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include "core/dataset.h"
+#include "core/simd.h"
+#include "core/thread_pool.h"
+
+namespace aicpp {
+
+/**
+ * @brief Writes out[r] = f(bias + X.row(r)·w) for every row of a rows x cols matrix.
+ * * Row-major input goes through the blocked SIMD gemv kernel; column-major input
+ * is scored column by column with axpy over a block of rows. Rows are split over
+ * the shared thread pool and each block's scores live on the stack, so nothing is
+ * allocated per call or per row. Results match a per-row dot product up to rounding.
+ */
+template <typename Out, typename Fn>
+void score_rows(const real* X, size_t rows, size_t cols, size_t ld, Layout layout,
+                const real* w, real bias, Out* out, Fn f) {
+
+    constexpr size_t kBlock = 256;
+    const size_t min_rows = std::max<size_t>(kBlock, (size_t(1) << 16) / std::max<size_t>(cols, 1));
+
+    parallel_for(rows, min_rows, [&](size_t, size_t begin, size_t end) {
+
+        real scores[kBlock];
+        for (size_t r0 = begin; r0 < end; r0 += kBlock) {
+
+            const size_t nb = std::min(kBlock, end - r0);
+
+            if (layout == Layout::RowMajor) {
+                simd::gemv(X + r0 * ld, nb, cols, ld, w, scores);
+            } else {
+                std::fill(scores, scores + nb, real(0));
+                for (size_t j = 0; j < cols; ++j) simd::axpy(w[j], X + j * ld + r0, scores, nb);
+            }
+
+            for (size_t i = 0; i < nb; ++i) out[r0 + i] = f(bias + scores[i]);
+        }
+    });
+}
+
+} // namespace aicpp
+
+#endif // AI_LAB_LINEAR_BATCH_H
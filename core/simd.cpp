@@ -0,0 +1,144 @@
+#include "core/simd.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#if defined(AICPP_SIMD_KERNELS) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define AICPP_SIMD_DISPATCH 1
+#endif
+
+namespace aicpp {
+namespace simd {
+
+namespace {
+
+// Four independent partial sums hide the FMA latency without changing the
+// summation order between runs
+
+real scalar_dot(const real* a, const real* b, size_t n) {
+    real s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+void scalar_axpy(real alpha, const real* x, real* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+real scalar_squared_l2(const real* a, const real* b, size_t n) {
+    real s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        real d0 = a[i] - b[i], d1 = a[i + 1] - b[i + 1];
+        real d2 = a[i + 2] - b[i + 2], d3 = a[i + 3] - b[i + 3];
+        s0 += d0 * d0;
+        s1 += d1 * d1;
+        s2 += d2 * d2;
+        s3 += d3 * d3;
+    }
+    for (; i < n; ++i) {
+        real d = a[i] - b[i];
+        s0 += d * d;
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+void scalar_multiply_accumulate(double alpha, const real* x, double* acc, size_t n) {
+    for (size_t i = 0; i < n; ++i) acc[i] += alpha * x[i];
+}
+
+void scalar_gemv(const real* A, size_t rows, size_t cols, size_t ld, const real* x, real* y) {
+    for (size_t r = 0; r < rows; ++r) y[r] = scalar_dot(A + r * ld, x, cols);
+}
+
+void scalar_gemm_nt(const real* A, size_t m, size_t lda, const real* B, size_t n, size_t ldb,
+                    size_t k, real* C, size_t ldc) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) C[i * ldc + j] = scalar_dot(A + i * lda, B + j * ldb, k);
+    }
+}
+
+#ifdef AICPP_SIMD_DISPATCH
+
+// XCR0 bits the OS must save on context switch for the register state to survive
+bool os_saves(uint64_t mask) {
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((static_cast<uint64_t>(edx) << 32 | eax) & mask) == mask;
+}
+
+Isa detect_cpu() {
+
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return Isa::Scalar;
+
+    const bool osxsave = c & bit_OSXSAVE, avx = c & bit_AVX, fma = c & bit_FMA;
+    if (!osxsave || !avx || !fma || !os_saves(0x6)) return Isa::Scalar;  // XMM | YMM
+
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return Isa::Scalar;
+
+    if ((b & bit_AVX512F) && os_saves(0xE6)) return Isa::AVX512;        // + opmask | ZMM
+    if (b & bit_AVX2) return Isa::AVX2;
+    return Isa::Scalar;
+}
+
+#else
+
+Isa detect_cpu() { return Isa::Scalar; }
+
+#endif
+
+Isa select_isa() {
+
+    Isa isa = detect_cpu();
+
+    if (const char* env = std::getenv("AICPP_SIMD")) {
+        std::string cap(env);
+        Isa limit = cap == "scalar" ? Isa::Scalar : cap == "avx2" ? Isa::AVX2 : Isa::AVX512;
+        if (limit < isa) isa = limit;
+    }
+    return isa;
+}
+
+} // namespace
+
+Isa active_isa() {
+    static const Isa isa = select_isa();
+    return isa;
+}
+
+const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX512: return "avx512";
+        case Isa::AVX2:   return "avx2";
+        default:          return "scalar";
+    }
+}
+
+const Kernels& scalar_kernels() {
+    static const Kernels k = { scalar_dot, scalar_axpy, scalar_squared_l2, scalar_multiply_accumulate,
+                                 scalar_gemv, scalar_gemm_nt };
+    return k;
+}
+
+const Kernels& kernels() {
+#ifdef AICPP_SIMD_DISPATCH
+    static const Kernels& k = active_isa() == Isa::AVX512 ? avx512_kernels()
+                            : active_isa() == Isa::AVX2   ? avx2_kernels()
+                                                          : scalar_kernels();
+#else
+    static const Kernels& k = scalar_kernels();
+#endif
+    return k;
+}
+
+} // namespace simd
+} // namespace aicpp
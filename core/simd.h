@@ -0,0 +1,85 @@
+#ifndef AI_LAB_SIMD_H
+#define AI_LAB_SIMD_H
+
+#include <cstddef>
+#include "core/data_types.h"
+
+namespace aicpp {
+namespace simd {
+
+/**
+ * @brief Instruction sets the kernels are compiled for, best last.
+ * * The best one supported by both the CPU (CPUID) and the OS (XCR0) is picked
+ * once at startup. AICPP_SIMD=scalar|avx2|avx512 caps the choice, which is
+ * useful for benchmarking or for reproducing results across machines.
+ */
+enum class Isa { Scalar, AVX2, AVX512 };
+
+/**
+ * @brief Function table for one instruction set; every entry works on any length
+ * and any alignment.
+ */
+struct Kernels {
+    // Σ a[i]·b[i]
+    real (*dot)(const real* a, const real* b, size_t n);
+
+    // y[i] += alpha·x[i]
+    void (*axpy)(real alpha, const real* x, real* y, size_t n);
+
+    // Σ (a[i] - b[i])²
+    real (*squared_l2)(const real* a, const real* b, size_t n);
+
+    // Fused multiply-reduce into double accumulators: acc[i] += alpha·x[i].
+    // Used for gradient, centroid and Gram sums, which stay double in float builds.
+    void (*multiply_accumulate)(double alpha, const real* x, double* acc, size_t n);
+
+    // y[r] = A.row(r)·x for a row-major rows x cols block with row stride ld;
+    // four rows share each load of x
+    void (*gemv)(const real* A, size_t rows, size_t cols, size_t ld, const real* x, real* y);
+
+    // C[i·ldc + j] = A.row(i)·B.row(j) for row-major A (m x k) and B (n x k), i.e. C = A·Bᵀ;
+    // register-blocked over 4 rows of A and 2 rows of B
+    void (*gemm_nt)(const real* A, size_t m, size_t lda, const real* B, size_t n, size_t ldb,
+                    size_t k, real* C, size_t ldc);
+};
+
+Isa active_isa();
+const char* isa_name(Isa isa);
+
+// Kernel table of the active instruction set
+const Kernels& kernels();
+
+inline real dot(const real* a, const real* b, size_t n) {
+    return kernels().dot(a, b, n);
+}
+
+inline void axpy(real alpha, const real* x, real* y, size_t n) {
+    kernels().axpy(alpha, x, y, n);
+}
+
+inline real squared_l2(const real* a, const real* b, size_t n) {
+    return kernels().squared_l2(a, b, n);
+}
+
+inline void multiply_accumulate(double alpha, const real* x, double* acc, size_t n) {
+    kernels().multiply_accumulate(alpha, x, acc, n);
+}
+
+inline void gemv(const real* A, size_t rows, size_t cols, size_t ld, const real* x, real* y) {
+    kernels().gemv(A, rows, cols, ld, x, y);
+}
+
+inline void gemm_nt(const real* A, size_t m, size_t lda, const real* B, size_t n, size_t ldb,
+                    size_t k, real* C, size_t ldc) {
+    kernels().gemm_nt(A, m, lda, B, n, ldb, k, C, ldc);
+}
+
+// Per-ISA tables; the vector ones exist only when AICPP_SIMD_KERNELS is defined
+const Kernels& scalar_kernels();
+const Kernels& avx2_kernels();
+const Kernels& avx512_kernels();
+
+} // namespace simd
+} // namespace aicpp
+
+#endif // AI_LAB_SIMD_H
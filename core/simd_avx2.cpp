@@ -0,0 +1,68 @@
+// Compiled with -mavx2 -mfma (see CMakeLists.txt); only called after CPUID confirms support
+#include "core/simd.h"
+
+#if defined(AICPP_SIMD_KERNELS) && defined(__AVX2__) && defined(__FMA__)
+
+#include <immintrin.h>
+#include "core/simd_impl.h"
+
+namespace aicpp {
+namespace simd {
+
+namespace {
+
+struct F64x4 {
+    using type = __m256d;
+    static constexpr size_t width = 4;
+    static type zero() { return _mm256_setzero_pd(); }
+    static type set1(double a) { return _mm256_set1_pd(a); }
+    static type load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, type v) { _mm256_storeu_pd(p, v); }
+    static type add(type a, type b) { return _mm256_add_pd(a, b); }
+    static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+    static double hsum(type v) {
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+#ifdef AICPP_USE_FLOAT
+    static type widen(const float* p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+#else
+    static type widen(const double* p) { return load(p); }
+#endif
+};
+
+struct F32x8 {
+    using type = __m256;
+    static constexpr size_t width = 8;
+    static type zero() { return _mm256_setzero_ps(); }
+    static type set1(float a) { return _mm256_set1_ps(a); }
+    static type load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+    static type add(type a, type b) { return _mm256_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+    static float hsum(type v) {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+    }
+};
+
+#ifdef AICPP_USE_FLOAT
+using Real = F32x8;
+#else
+using Real = F64x4;
+#endif
+
+} // namespace
+
+const Kernels& avx2_kernels() {
+    static const Kernels k = impl::make_kernels<Real, F64x4>();
+    return k;
+}
+
+} // namespace simd
+} // namespace aicpp
+
+#endif
@@ -0,0 +1,72 @@
+// Compiled with -mavx512f -mfma (see CMakeLists.txt); only called after CPUID confirms support
+#include "core/simd.h"
+
+#if defined(AICPP_SIMD_KERNELS) && defined(__AVX512F__)
+
+#include <immintrin.h>
+#include "core/simd_impl.h"
+
+namespace aicpp {
+namespace simd {
+
+namespace {
+
+struct F64x8 {
+    using type = __m512d;
+    static constexpr size_t width = 8;
+    static type zero() { return _mm512_setzero_pd(); }
+    static type set1(double a) { return _mm512_set1_pd(a); }
+    static type load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, type v) { _mm512_storeu_pd(p, v); }
+    static type add(type a, type b) { return _mm512_add_pd(a, b); }
+    static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+    // Through memory: GCC 12's _mm512_reduce_add_pd trips -Wuninitialized
+    static double hsum(type v) {
+        alignas(64) double t[width];
+        _mm512_store_pd(t, v);
+        return ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+    }
+#ifdef AICPP_USE_FLOAT
+    static type widen(const float* p) { return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(p)); }
+#else
+    static type widen(const double* p) { return load(p); }
+#endif
+};
+
+struct F32x16 {
+    using type = __m512;
+    static constexpr size_t width = 16;
+    static type zero() { return _mm512_setzero_ps(); }
+    static type set1(float a) { return _mm512_set1_ps(a); }
+    static type load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, type v) { _mm512_storeu_ps(p, v); }
+    static type add(type a, type b) { return _mm512_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+    static type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+    static float hsum(type v) {
+        alignas(64) float t[width];
+        _mm512_store_ps(t, v);
+        float s = 0;
+        for (size_t i = 0; i < width; ++i) s += t[i];
+        return s;
+    }
+};
+
+#ifdef AICPP_USE_FLOAT
+using Real = F32x16;
+#else
+using Real = F64x8;
+#endif
+
+} // namespace
+
+const Kernels& avx512_kernels() {
+    static const Kernels k = impl::make_kernels<Real, F64x8>();
+    return k;
+}
+
+} // namespace simd
+} // namespace aicpp
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef AI_LAB_SIMD_IMPL_H
+#define AI_LAB_SIMD_IMPL_H
+
+// Kernel bodies shared by the per-ISA translation units. Each unit defines a
+// vector traits struct V (register type, lane count, load/store/fmadd/...) and a
+// widen() helper, then instantiates make_kernels<V>(). Only include from simd_*.cpp.
+
+#include <cstddef>
+#include "core/simd.h"
+
+namespace aicpp {
+namespace simd {
+namespace impl {
+
+template <typename V>
+real dot(const real* a, const real* b, size_t n) {
+    typename V::type s0 = V::zero(), s1 = V::zero();
+    size_t i = 0;
+    for (; i + 2 * V::width <= n; i += 2 * V::width) {
+        s0 = V::fmadd(V::load(a + i), V::load(b + i), s0);
+        s1 = V::fmadd(V::load(a + i + V::width), V::load(b + i + V::width), s1);
+    }
+    if (i + V::width <= n) {
+        s0 = V::fmadd(V::load(a + i), V::load(b + i), s0);
+        i += V::width;
+    }
+    real s = V::hsum(V::add(s0, s1));
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+template <typename V>
+void axpy(real alpha, const real* x, real* y, size_t n) {
+    const typename V::type va = V::set1(alpha);
+    size_t i = 0;
+    for (; i + V::width <= n; i += V::width) V::store(y + i, V::fmadd(va, V::load(x + i), V::load(y + i)));
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+template <typename V>
+real squared_l2(const real* a, const real* b, size_t n) {
+    typename V::type s0 = V::zero(), s1 = V::zero();
+    size_t i = 0;
+    for (; i + 2 * V::width <= n; i += 2 * V::width) {
+        typename V::type d0 = V::sub(V::load(a + i), V::load(b + i));
+        typename V::type d1 = V::sub(V::load(a + i + V::width), V::load(b + i + V::width));
+        s0 = V::fmadd(d0, d0, s0);
+        s1 = V::fmadd(d1, d1, s1);
+    }
+    if (i + V::width <= n) {
+        typename V::type d0 = V::sub(V::load(a + i), V::load(b + i));
+        s0 = V::fmadd(d0, d0, s0);
+        i += V::width;
+    }
+    real s = V::hsum(V::add(s0, s1));
+    for (; i < n; ++i) {
+        real d = a[i] - b[i];
+        s += d * d;
+    }
+    return s;
+}
+
+// D is the double-precision traits struct; D::widen loads D::width reals as doubles
+template <typename D>
+void multiply_accumulate(double alpha, const real* x, double* acc, size_t n) {
+    const typename D::type va = D::set1(alpha);
+    size_t i = 0;
+    for (; i + D::width <= n; i += D::width) D::store(acc + i, D::fmadd(va, D::widen(x + i), D::load(acc + i)));
+    for (; i < n; ++i) acc[i] += alpha * x[i];
+}
+
+template <typename V>
+void gemv(const real* A, size_t rows, size_t cols, size_t ld, const real* x, real* y) {
+
+    size_t r = 0;
+    for (; r + 4 <= rows; r += 4) {
+
+        const real* a0 = A + r * ld;
+        const real* a1 = a0 + ld;
+        const real* a2 = a1 + ld;
+        const real* a3 = a2 + ld;
+
+        typename V::type s0 = V::zero(), s1 = V::zero(), s2 = V::zero(), s3 = V::zero();
+        size_t j = 0;
+        for (; j + V::width <= cols; j += V::width) {
+            const typename V::type xv = V::load(x + j);
+            s0 = V::fmadd(V::load(a0 + j), xv, s0);
+            s1 = V::fmadd(V::load(a1 + j), xv, s1);
+            s2 = V::fmadd(V::load(a2 + j), xv, s2);
+            s3 = V::fmadd(V::load(a3 + j), xv, s3);
+        }
+
+        real t0 = V::hsum(s0), t1 = V::hsum(s1), t2 = V::hsum(s2), t3 = V::hsum(s3);
+        for (; j < cols; ++j) {
+            t0 += a0[j] * x[j];
+            t1 += a1[j] * x[j];
+            t2 += a2[j] * x[j];
+            t3 += a3[j] * x[j];
+        }
+        y[r] = t0;
+        y[r + 1] = t1;
+        y[r + 2] = t2;
+        y[r + 3] = t3;
+    }
+    for (; r < rows; ++r) y[r] = dot<V>(A + r * ld, x, cols);
+}
+
+template <typename V>
+void gemm_nt(const real* A, size_t m, size_t lda, const real* B, size_t n, size_t ldb,
+             size_t k, real* C, size_t ldc) {
+
+    using T = typename V::type;
+
+    size_t i = 0;
+    for (; i + 4 <= m; i += 4) {
+
+        const real* a[4] = { A + i * lda, A + (i + 1) * lda, A + (i + 2) * lda, A + (i + 3) * lda };
+
+        size_t j = 0;
+        for (; j + 2 <= n; j += 2) {
+
+            const real* b0 = B + j * ldb;
+            const real* b1 = b0 + ldb;
+
+            // 4 x 2 block of dot products: 8 accumulators, 6 loads per 8 FMAs
+            T s00 = V::zero(), s01 = V::zero(), s10 = V::zero(), s11 = V::zero();
+            T s20 = V::zero(), s21 = V::zero(), s30 = V::zero(), s31 = V::zero();
+
+            size_t p = 0;
+            for (; p + V::width <= k; p += V::width) {
+                const T v0 = V::load(b0 + p), v1 = V::load(b1 + p);
+                T x = V::load(a[0] + p);
+                s00 = V::fmadd(x, v0, s00);
+                s01 = V::fmadd(x, v1, s01);
+                x = V::load(a[1] + p);
+                s10 = V::fmadd(x, v0, s10);
+                s11 = V::fmadd(x, v1, s11);
+                x = V::load(a[2] + p);
+                s20 = V::fmadd(x, v0, s20);
+                s21 = V::fmadd(x, v1, s21);
+                x = V::load(a[3] + p);
+                s30 = V::fmadd(x, v0, s30);
+                s31 = V::fmadd(x, v1, s31);
+            }
+
+            real t[4][2] = { { V::hsum(s00), V::hsum(s01) }, { V::hsum(s10), V::hsum(s11) },
+                             { V::hsum(s20), V::hsum(s21) }, { V::hsum(s30), V::hsum(s31) } };
+            for (; p < k; ++p) {
+                for (int r = 0; r < 4; ++r) {
+                    t[r][0] += a[r][p] * b0[p];
+                    t[r][1] += a[r][p] * b1[p];
+                }
+            }
+            for (int r = 0; r < 4; ++r) {
+                C[(i + r) * ldc + j] = t[r][0];
+                C[(i + r) * ldc + j + 1] = t[r][1];
+            }
+        }
+        for (; j < n; ++j) {
+            for (int r = 0; r < 4; ++r) C[(i + r) * ldc + j] = dot<V>(a[r], B + j * ldb, k);
+        }
+    }
+    for (; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) C[i * ldc + j] = dot<V>(A + i * lda, B + j * ldb, k);
+    }
+}
+
+template <typename V, typename D>
+Kernels make_kernels() {
+    return { dot<V>, axpy<V>, squared_l2<V>, multiply_accumulate<D>, gemv<V>, gemm_nt<V> };
+}
+
+} // namespace impl
+} // namespace simd
+} // namespace aicpp
+
+#endif // AI_LAB_SIMD_IMPL_H
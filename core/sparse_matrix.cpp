@@ -0,0 +1,95 @@
+#include "core/sparse_matrix.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace aicpp {
+
+SparseMatrix SparseMatrix::from_dense(const Dataset& data) {
+
+    SparseMatrix m(data.cols());
+    m.row_offsets_.reserve(data.rows() + 1);
+
+    std::vector<index_type> idx;
+    std::vector<real> val;
+
+    for (size_t r = 0; r < data.rows(); ++r) {
+
+        idx.clear();
+        val.clear();
+
+        RowView row = data.row(r);
+        for (size_t c = 0; c < row.size(); ++c) {
+            if (row[c] != 0) {
+                idx.push_back(static_cast<index_type>(c));
+                val.push_back(row[c]);
+            }
+        }
+
+        if (data.has_labels()) m.add_row(idx.data(), val.data(), idx.size(), data.label(r));
+        else m.add_row(idx.data(), val.data(), idx.size());
+    }
+    return m;
+}
+
+void SparseMatrix::reserve(size_t rows, size_t nnz) {
+    row_offsets_.reserve(rows + 1);
+    indices_.reserve(nnz);
+    values_.reserve(nnz);
+}
+
+void SparseMatrix::append(const index_type* indices, const real* values, size_t nnz) {
+
+    for (size_t i = 1; i < nnz; ++i) {
+        if (indices[i] <= indices[i - 1]) {
+            throw std::runtime_error("Sparse row indices must be strictly increasing.");
+        }
+    }
+
+    indices_.insert(indices_.end(), indices, indices + nnz);
+    values_.insert(values_.end(), values, values + nnz);
+    row_offsets_.push_back(indices_.size());
+
+    if (nnz > 0) cols_ = std::max<size_t>(cols_, static_cast<size_t>(indices[nnz - 1]) + 1);
+}
+
+void SparseMatrix::add_row(const index_type* indices, const real* values, size_t nnz) {
+    if (has_labels()) throw std::runtime_error("Labelled sparse matrix requires a label per row.");
+    append(indices, values, nnz);
+}
+
+void SparseMatrix::add_row(const index_type* indices, const real* values, size_t nnz, real label) {
+    if (!empty() && !has_labels()) throw std::runtime_error("Sparse matrix rows are unlabelled.");
+    append(indices, values, nnz);
+    labels_.push_back(label);
+}
+
+void SparseMatrix::set_cols(size_t cols) {
+
+    size_t used = 0;
+    for (index_type c : indices_) used = std::max<size_t>(used, static_cast<size_t>(c) + 1);
+
+    if (cols < used) throw std::runtime_error("Sparse matrix already uses a column past the new width.");
+    cols_ = cols;
+}
+
+void SparseMatrix::clear() {
+    cols_ = 0;
+    row_offsets_.assign(1, 0);
+    indices_.clear();
+    values_.clear();
+    labels_.clear();
+}
+
+std::vector<SparseMatrix::index_type> SparseMatrix::active_columns() const {
+
+    std::vector<char> seen(cols_, 0);
+    for (index_type c : indices_) seen[c] = 1;
+
+    std::vector<index_type> out;
+    for (size_t c = 0; c < cols_; ++c) {
+        if (seen[c]) out.push_back(static_cast<index_type>(c));
+    }
+    return out;
+}
+
+} // namespace aicpp
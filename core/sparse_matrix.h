@@ -0,0 +1,88 @@
+#ifndef AI_LAB_SPARSE_MATRIX_H
+#define AI_LAB_SPARSE_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/data_types.h"
+#include "core/dataset.h"
+
+namespace aicpp {
+
+/**
+ * @brief Non-owning view of one sparse row: nnz (index, value) pairs.
+ */
+struct SparseRow {
+    const uint32_t* indices = nullptr;
+    const real* values = nullptr;
+    size_t nnz = 0;
+};
+
+/**
+ * @brief Compressed sparse row (CSR) feature matrix with an optional label array.
+ * * Only nonzeros are stored, so memory and per-row work are proportional to the
+ * nonzero count rather than to cols(). Column indices are 32-bit, which covers
+ * hashed feature spaces of up to 2^32 columns.
+ */
+class SparseMatrix {
+public:
+
+    using index_type = uint32_t;
+
+    SparseMatrix() = default;
+
+    // Empty matrix with a fixed column count (rows are appended with add_row)
+    explicit SparseMatrix(size_t cols) : cols_(cols) {}
+
+    // Nonzero entries of a dense dataset; labels are kept
+    static SparseMatrix from_dense(const Dataset& data);
+
+    void reserve(size_t rows, size_t nnz);
+
+    // Appends a row; indices must be strictly increasing. cols() grows to cover them.
+    // Rows are either all labelled or all unlabelled.
+    void add_row(const index_type* indices, const real* values, size_t nnz);
+    void add_row(const index_type* indices, const real* values, size_t nnz, real label);
+
+    // Widens the matrix (e.g. to a known hashed feature space); cannot shrink below a used column
+    void set_cols(size_t cols);
+
+    void clear();
+
+    size_t rows() const { return row_offsets_.size() - 1; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return values_.size(); }
+    bool empty() const { return rows() == 0; }
+
+    SparseRow row(size_t r) const {
+        size_t b = row_offsets_[r];
+        return { indices_.data() + b, values_.data() + b, row_offsets_[r + 1] - b };
+    }
+
+    // Raw CSR arrays: row r spans [row_offsets()[r], row_offsets()[r + 1])
+    const std::vector<size_t>& row_offsets() const { return row_offsets_; }
+    const std::vector<index_type>& indices() const { return indices_; }
+    const std::vector<real>& values() const { return values_; }
+
+    // --- Labels ---
+    bool has_labels() const { return !labels_.empty(); }
+    const real* labels() const { return labels_.data(); }
+    real label(size_t r) const { return labels_[r]; }
+
+    // Sorted list of the columns that hold at least one nonzero
+    std::vector<index_type> active_columns() const;
+
+private:
+
+    void append(const index_type* indices, const real* values, size_t nnz);
+
+    size_t cols_ = 0;
+    std::vector<size_t> row_offsets_{0};
+    std::vector<index_type> indices_;
+    std::vector<real> values_;
+    std::vector<real> labels_;
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_SPARSE_MATRIX_H
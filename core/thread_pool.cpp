@@ -0,0 +1,133 @@
+#include "core/thread_pool.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace aicpp {
+
+namespace {
+// Set while a thread executes pool tasks; nested run() calls then execute inline
+thread_local bool t_inside_pool = false;
+}
+
+ThreadPool::ThreadPool(size_t num_threads) {
+
+    if (num_threads == 0) num_threads = default_threads();
+    for (size_t i = 1; i < num_threads; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& w : workers_) w.join();
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+size_t ThreadPool::default_threads() {
+
+    if (const char* env = std::getenv("AICPP_NUM_THREADS")) {
+        long n = std::strtol(env, nullptr, 10);
+        if (n > 0) return static_cast<size_t>(n);
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ThreadPool::drain(const std::function<void(size_t)>& task, size_t count) {
+
+    bool was_inside = t_inside_pool;
+    t_inside_pool = true;
+
+    for (size_t i = next_.fetch_add(1); i < count; i = next_.fetch_add(1)) {
+        try {
+            task(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+
+    t_inside_pool = was_inside;
+}
+
+void ThreadPool::worker_loop() {
+
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+
+        seen = generation_;
+        const auto* task = task_;
+        if (!task) continue;  // woke up after the job already finished
+
+        size_t count = count_;
+        ++active_;
+
+        lock.unlock();
+        drain(*task, count);
+        lock.lock();
+
+        if (--active_ == 0) done_cv_.notify_all();
+    }
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)>& task) {
+
+    if (count == 0) return;
+
+    if (t_inside_pool || workers_.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_.store(0);
+        error_ = nullptr;
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    drain(task, count);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [&] { return active_ == 0; });
+        task_ = nullptr;
+        error = error_;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+size_t parallel_chunks(size_t n, size_t min_chunk) {
+
+    if (n == 0) return 0;
+    min_chunk = std::max<size_t>(min_chunk, 1);
+    size_t by_size = (n + min_chunk - 1) / min_chunk;
+    return std::min(ThreadPool::instance().size(), by_size);
+}
+
+void parallel_for(size_t n, size_t min_chunk,
+                  const std::function<void(size_t chunk, size_t begin, size_t end)>& body) {
+
+    size_t chunks = parallel_chunks(n, min_chunk);
+    ThreadPool::instance().run(chunks, [&](size_t c) {
+        body(c, n * c / chunks, n * (c + 1) / chunks);
+    });
+}
+
+} // namespace aicpp
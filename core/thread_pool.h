@@ -0,0 +1,77 @@
+#ifndef AI_LAB_THREAD_POOL_H
+#define AI_LAB_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aicpp {
+
+/**
+ * @brief Fixed set of worker threads that execute indexed tasks.
+ * * run() blocks until every task index has been processed; the calling thread
+ * takes part in the work. Calls made from inside a task run inline, so nested
+ * parallel sections never deadlock.
+ */
+class ThreadPool {
+public:
+
+    // num_threads counts the calling thread as well (0 = default_threads())
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    // Executes task(i) for every i in [0, count); rethrows the first task exception
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    // Process-wide pool sized by default_threads()
+    static ThreadPool& instance();
+
+    // AICPP_NUM_THREADS if set, otherwise std::thread::hardware_concurrency()
+    static size_t default_threads();
+
+private:
+
+    void worker_loop();
+    void drain(const std::function<void(size_t)>& task, size_t count);
+
+    std::vector<std::thread> workers_;
+
+    std::mutex run_mutex_;  // one job at a time
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t active_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
+
+// Number of chunks parallel_for() will use for n items of at least min_chunk each
+size_t parallel_chunks(size_t n, size_t min_chunk = 1);
+
+/**
+ * @brief Splits [0, n) into parallel_chunks(n, min_chunk) contiguous ranges and
+ * calls body(chunk, begin, end) for each on the shared pool. The chunk index is
+ * stable, so callers can keep per-chunk accumulators and reduce them afterwards.
+ */
+void parallel_for(size_t n, size_t min_chunk,
+                  const std::function<void(size_t chunk, size_t begin, size_t end)>& body);
+
+} // namespace aicpp
+
+#endif // AI_LAB_THREAD_POOL_H
@@ -0,0 +1,82 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include "core/data_types.h"
+
+// Low-level numeric CSV scanning shared by the in-memory and streaming loaders
+namespace csv_detail {
+
+inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* find_eol(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+// True if [p, eol) holds anything other than blanks
+inline bool has_content(const char* p, const char* eol) {
+    while (p < eol && is_blank(*p)) ++p;
+    return p < eol;
+}
+
+// Number of fields in the header line, split the same way std::getline would split it
+inline size_t count_fields(const char* p, const char* eol, char delimiter) {
+
+    while (eol > p && eol[-1] == '\r') --eol;
+    if (p == eol) return 0;
+
+    size_t n = static_cast<size_t>(std::count(p, eol, delimiter)) + 1;
+    if (eol[-1] == delimiter) --n;
+    return n;
+}
+
+// Parses one numeric field starting at p; returns the position after it, or nullptr on error.
+// Mirrors std::stod leniency: leading blanks and a leading '+' are accepted.
+template <typename T>
+inline const char* parse_field(const char* p, const char* eol, T& out) {
+
+    while (p < eol && is_blank(*p)) ++p;
+    if (p < eol && *p == '+') ++p;
+
+    auto res = std::from_chars(p, eol, out);
+    if (res.ec != std::errc()) return nullptr;
+
+    p = res.ptr;
+    while (p < eol && is_blank(*p)) ++p;
+    return p;
+}
+
+/**
+ * Parses the non-blank line [p, eol) into num_cols values, routing the label column to
+ * `labels` and the rest to `features`. Fields past num_cols are ignored.
+ * Returns num_cols on success, otherwise the index of the malformed column.
+ */
+template <typename FeatureOut, typename LabelOut>
+inline size_t parse_numeric_line(const char* p, const char* eol, size_t num_cols,
+                                 int label_col_index, char delimiter,
+                                 FeatureOut& features, LabelOut& labels) {
+
+    for (size_t j = 0; j < num_cols; ++j) {
+
+        aicpp::real val;
+        const char* next = parse_field(p, eol, val);
+        bool last = (j + 1 == num_cols);
+
+        if (!next || (!last && (next == eol || *next != delimiter))
+                  || (last && next != eol && *next != delimiter)) {
+            return j;
+        }
+
+        if (static_cast<int>(j) == label_col_index) *labels++ = val;
+        else *features++ = val;
+
+        p = next + 1;
+    }
+    return num_cols;
+}
+
+} // namespace csv_detail
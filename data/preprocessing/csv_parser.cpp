@@ -1,9 +1,83 @@
 #include "csv_parser.h"
+#include "csv_numeric.h"
+#include "mapped_file.h"
+#include "core/thread_pool.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
 
+using namespace csv_detail;
+
+namespace {
+
+size_t line_number(const char* file_begin, const char* pos) {
+    return static_cast<size_t>(std::count(file_begin, pos, '\n')) + 1;
+}
+
+// Number of non-blank lines in [begin, end), i.e. the rows csv_parse_numeric_rows will emit
+size_t count_rows(const char* begin, const char* end) {
+
+    size_t rows = 0;
+    for (const char* p = begin; p < end; ) {
+        const char* eol = find_eol(p, end);
+        if (has_content(p, eol)) ++rows;
+        p = eol + 1;
+    }
+    return rows;
+}
+
+// Parses every complete line in [begin, end), writing features and labels through the
+// given output iterators. Blank lines are skipped; fields past num_cols are ignored.
+template <typename FeatureOut, typename LabelOut>
+bool csv_parse_numeric_rows(const char* begin, const char* end, const char* file_begin,
+                            size_t num_cols, int label_col_index, char delimiter,
+                            FeatureOut features, LabelOut labels) {
+
+    const char* p = begin;
+    while (p < end) {
+
+        const char* eol = find_eol(p, end);
+
+        if (!has_content(p, eol)) { p = eol + 1; continue; }
+
+        size_t col = parse_numeric_line(p, eol, num_cols, label_col_index, delimiter, features, labels);
+        if (col != num_cols) {
+            std::cerr << "CSV parse error at line " << line_number(file_begin, p)
+                      << ", column " << col + 1 << "\n";
+            return false;
+        }
+
+        p = eol + 1;
+    }
+    return true;
+}
+
+// Locates the header; returns the number of columns and sets body to the first data byte
+bool csv_read_header(const char* data, size_t size, int label_col_index, char delimiter,
+                     size_t& num_cols, const char*& body) {
+
+    const char* end = data + size;
+    const char* eol = find_eol(data, end);
+
+    num_cols = count_fields(data, eol, delimiter);
+    body = (eol < end) ? eol + 1 : end;
+
+    if (num_cols == 0) {
+        std::cerr << "CSV file has an empty header row\n";
+        return false;
+    }
+    if (label_col_index >= static_cast<int>(num_cols)) {
+        std::cerr << "Label column " << label_col_index << " is out of range (" << num_cols << " columns)\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+
 std::vector<std::vector<std::string>> CSVParser::readCSV(const std::string& filename, char delimiter) {
     
     std::vector<std::vector<std::string>> output;
@@ -31,3 +105,88 @@ std::vector<std::vector<std::string>> CSVParser::readCSV(const std::string& file
     file.close();
     return output;
 }
+
+bool CSVParser::readNumeric(const std::string& filename, aicpp::Dataset& out,
+                            int label_col_index, char delimiter) {
+    return readNumericParallel(filename, out, label_col_index, delimiter, 1);
+}
+
+bool CSVParser::readNumericParallel(const std::string& filename, aicpp::Dataset& out,
+                                    int label_col_index, char delimiter, size_t num_threads) {
+
+    out = aicpp::Dataset();
+
+    MappedFile file;
+    if (!file.open(filename)) return false;
+    if (file.size() == 0) return true;
+
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    size_t num_cols;
+    const char* body;
+    if (!csv_read_header(data, file.size(), label_col_index, delimiter, num_cols, body)) return false;
+
+    size_t feature_cols = num_cols - (label_col_index >= 0 ? 1 : 0);
+    bool has_labels = label_col_index >= 0;
+
+    // Split the body into byte ranges and move every cut forward to the next line start
+    const size_t min_chunk_bytes = 1 << 20;
+    size_t body_size = static_cast<size_t>(end - body);
+    size_t chunks = aicpp::parallel_chunks(body_size, min_chunk_bytes);
+    if (num_threads > 0) chunks = std::min(chunks, num_threads);
+    if (chunks == 0) {
+        // Header only: no rows, but keep the header's width
+        out = aicpp::Dataset(0, feature_cols);
+        return true;
+    }
+
+    std::vector<const char*> cuts(chunks + 1, end);
+    cuts[0] = body;
+    for (size_t c = 1; c < chunks; ++c) {
+        const char* p = std::max(body + body_size * c / chunks, cuts[c - 1]);
+        if (p > body && p < end && p[-1] != '\n') p = std::min(find_eol(p, end) + 1, end);
+        cuts[c] = p;
+    }
+
+    // Pass 1: exact row count per chunk gives each chunk its output offset
+    std::vector<size_t> row_offset(chunks + 1, 0);
+    aicpp::ThreadPool::instance().run(chunks, [&](size_t c) {
+        row_offset[c + 1] = count_rows(cuts[c], cuts[c + 1]);
+    });
+    for (size_t c = 0; c < chunks; ++c) row_offset[c + 1] += row_offset[c];
+
+    aicpp::Dataset result(row_offset[chunks], feature_cols);
+    aicpp::real* features = result.mutable_data();
+    aicpp::real* labels = has_labels ? result.mutable_labels() : nullptr;
+
+    // Pass 2: every chunk parses straight into its slice of the shared output
+    std::vector<char> ok(chunks, 1);
+    aicpp::ThreadPool::instance().run(chunks, [&](size_t c) {
+        aicpp::real* f = features + row_offset[c] * feature_cols;
+        aicpp::real* l = labels ? labels + row_offset[c] : nullptr;
+        ok[c] = csv_parse_numeric_rows(cuts[c], cuts[c + 1], data, num_cols,
+                                       label_col_index, delimiter, f, l);
+    });
+
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) return false;
+
+    out = std::move(result);
+    return true;
+}
+
+bool CSVParser::readNumeric(const std::string& filename,
+                            std::vector<std::vector<double>>& features,
+                            std::vector<double>& labels,
+                            int label_col_index, char delimiter, size_t num_threads) {
+
+    aicpp::Dataset table;
+    if (!readNumericParallel(filename, table, label_col_index, delimiter, num_threads)) return false;
+
+    features.reserve(features.size() + table.rows());
+    for (size_t i = 0; i < table.rows(); ++i)
+        features.emplace_back(table.row_ptr(i), table.row_ptr(i) + table.cols());
+
+    if (table.has_labels()) labels.insert(labels.end(), table.labels(), table.labels() + table.rows());
+    return true;
+}
@@ -1,10 +1,31 @@
 #pragma once
+#include <cstddef>
 #include <string>
 #include <vector>
+#include "core/dataset.h"
 
 
 class CSVParser {
 public:
     // Reads CSV file and returns rows as a vector of string vectors
     static std::vector<std::vector<std::string>> readCSV(const std::string& filename, char delimiter = ',');
+
+    // Memory-maps a CSV file and parses it straight into a row-major Dataset, skipping the header row.
+    // label_col_index selects the label column (negative = no labels). Returns false on error.
+    static bool readNumeric(const std::string& filename, aicpp::Dataset& out,
+                            int label_col_index, char delimiter = ',');
+
+    // Multi-threaded readNumeric: the file is split into byte ranges cut at line boundaries,
+    // parsed concurrently and written in file order. num_threads = 0 uses the shared pool size.
+    static bool readNumericParallel(const std::string& filename, aicpp::Dataset& out,
+                                    int label_col_index, char delimiter = ',',
+                                    size_t num_threads = 0);
+
+    // Drop-in replacement for readCSV + DataPreprocessor::toNumeric
+    // (num_threads = 1 parses on the calling thread, otherwise as readNumericParallel)
+    static bool readNumeric(const std::string& filename,
+                            std::vector<std::vector<double>>& features,
+                            std::vector<double>& labels,
+                            int label_col_index, char delimiter = ',',
+                            size_t num_threads = 1);
 };
@@ -1,7 +1,9 @@
 #include "data_preprocessor.h"
+#include "feature_scaler.h"
 #include <limits>
 #include <cmath>
 #include <cstdlib>
+#include <stdexcept>
 
 
 void DataPreprocessor::toNumeric(const std::vector<std::vector<std::string>>& raw,
@@ -28,6 +30,41 @@ void DataPreprocessor::toNumeric(const std::vector<std::vector<std::string>>& ra
     }
 }
 
+void DataPreprocessor::toNumeric(const std::vector<std::vector<std::string>>& raw,
+                                 aicpp::Dataset& data,
+                                 int label_col_index) {
+    data = aicpp::Dataset();
+    if (raw.empty()) return;
+
+    // Rows are written straight into a contiguous buffer, so check every shape first
+    size_t m = raw[0].size();
+    if (label_col_index < 0 || static_cast<size_t>(label_col_index) >= m) {
+        throw std::invalid_argument("Label column " + std::to_string(label_col_index) +
+                                    " is out of range for " + std::to_string(m) + " columns.");
+    }
+    for (size_t i = 1; i < raw.size(); ++i) {
+        if (raw[i].size() != m) {
+            throw std::invalid_argument("Row " + std::to_string(i) + " has " + std::to_string(raw[i].size()) +
+                                        " cells; the header has " + std::to_string(m) + ".");
+        }
+    }
+    if (raw.size() < 2) return;
+
+    size_t n = raw.size() - 1;
+    data = aicpp::Dataset(n, m - 1);
+    aicpp::real* labels = data.mutable_labels();
+
+    // Skip header (row 0)
+    for (size_t i = 0; i < n; ++i) {
+        aicpp::real* row = data.row_ptr(i);
+        for (size_t j = 0; j < m; ++j) {
+            aicpp::real val = static_cast<aicpp::real>(std::stod(raw[i + 1][j]));
+            if ((int)j == label_col_index) labels[i] = val;
+            else *row++ = val;
+        }
+    }
+}
+
 void DataPreprocessor::normalize(std::vector<std::vector<double>>& features) {
 
     if (features.empty()) return;
@@ -57,3 +94,7 @@ void DataPreprocessor::normalize(std::vector<std::vector<double>>& features) {
         }
     }
 }
+
+void DataPreprocessor::normalize(aicpp::Dataset& data) {
+    FeatureScaler(FeatureScaler::Method::MinMax).fit_transform(data);
+}
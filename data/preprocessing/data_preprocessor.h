@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <string>
+#include "core/dataset.h"
 
 class DataPreprocessor {
     
@@ -11,6 +12,13 @@ public:
                           std::vector<double>& labels,
                           int label_col_index);
 
+    // Same conversion into a contiguous Dataset (labels go to its label array)
+    static void toNumeric(const std::vector<std::vector<std::string>>& raw,
+                          aicpp::Dataset& data,
+                          int label_col_index);
+
     // Normalizes features to [0,1] range
+    // (use FeatureScaler to keep the parameters for later inputs)
     static void normalize(std::vector<std::vector<double>>& features);
+    static void normalize(aicpp::Dataset& data);
 };
@@ -0,0 +1,267 @@
+#include "dataset_cache.h"
+#include "csv_parser.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+
+
+namespace {
+
+const char kMagic[8] = {'A', 'I', 'L', 'A', 'B', 'D', 'S', '1'};
+const uint32_t kVersion = 2;  // 1 stored one block per column
+const uint32_t kByteOrderMark = 0x01020304;
+const uint32_t kTypeFloat64 = 1;
+const uint32_t kTypeFloat32 = 2;
+const uint32_t kValueType = sizeof(aicpp::real) == sizeof(float) ? kTypeFloat32 : kTypeFloat64;
+const size_t kAlign = 64;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t rows;
+    uint64_t cols;              // feature columns
+    uint32_t value_type;        // kTypeFloat32 / kTypeFloat64, same for every block
+    uint32_t has_labels;
+    int32_t label_col_index;
+    int32_t delimiter;
+    uint64_t source_size;
+    int64_t source_mtime_ns;
+    uint64_t names_bytes;       // length-prefixed column names right after the header
+    uint64_t data_offset;       // row-major feature block, kAlign-aligned
+    uint64_t labels_offset;     // label block after it, kAlign-aligned
+};
+
+size_t align_up(size_t n) {
+    return (n + kAlign - 1) / kAlign * kAlign;
+}
+
+bool source_identity(const std::string& path, uint64_t& size, int64_t& mtime_ns) {
+
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return false;
+
+    size = static_cast<uint64_t>(st.st_size);
+    mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    return true;
+}
+
+std::vector<std::string> read_header_names(const std::string& csv_path, char delimiter) {
+
+    std::vector<std::string> names;
+    std::ifstream file(csv_path);
+    std::string line;
+    if (!std::getline(file, line)) return names;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    std::stringstream ss(line);
+    std::string cell;
+    while (std::getline(ss, cell, delimiter)) names.push_back(cell);
+    return names;
+}
+
+/**
+ * Checks that the names and both blocks lie inside a file of file_size bytes, in
+ * order and without overlap; written without products that could overflow, so a
+ * truncated or corrupt header is rejected instead of read out of bounds.
+ */
+bool layout_fits(const CacheHeader& h, uint64_t file_size) {
+
+    const uint64_t value = sizeof(aicpp::real);
+
+    if (h.has_labels > 1 || h.data_offset % kAlign != 0 || h.labels_offset % kAlign != 0) return false;
+    if (h.data_offset < sizeof(CacheHeader) || h.names_bytes > h.data_offset - sizeof(CacheHeader)) return false;
+    if (h.data_offset > h.labels_offset || h.labels_offset > file_size) return false;
+
+    // rows x cols values must fit between the two block offsets
+    const uint64_t feature_room = (h.labels_offset - h.data_offset) / value;
+    if (h.cols > 0 && h.rows > feature_room / h.cols) return false;
+
+    return !h.has_labels || h.rows <= (file_size - h.labels_offset) / value;
+}
+
+void write_padding(std::ofstream& out, size_t bytes) {
+    static const char zeros[kAlign] = {};
+    while (bytes > 0) {
+        size_t n = std::min(bytes, kAlign);
+        out.write(zeros, static_cast<std::streamsize>(n));
+        bytes -= n;
+    }
+}
+
+} // namespace
+
+
+std::string DatasetCache::cachePathFor(const std::string& csv_path) {
+    return csv_path + ".aicache";
+}
+
+bool DatasetCache::write(const std::string& cache_path, const aicpp::Dataset& table,
+                         const std::vector<std::string>& column_names,
+                         const std::string& source_csv, int label_col_index, char delimiter) {
+
+    CacheHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.byte_order = kByteOrderMark;
+    h.rows = table.rows();
+    h.cols = table.cols();
+    h.value_type = kValueType;
+    h.has_labels = table.has_labels() ? 1 : 0;
+    h.label_col_index = label_col_index;
+    h.delimiter = delimiter;
+
+    if (!source_identity(source_csv, h.source_size, h.source_mtime_ns)) {
+        std::cerr << "Could not stat source file: " << source_csv << "\n";
+        return false;
+    }
+
+    for (const auto& name : column_names) h.names_bytes += sizeof(uint32_t) + name.size();
+    h.data_offset = align_up(sizeof(CacheHeader) + h.names_bytes);
+    h.labels_offset = h.data_offset + align_up(table.rows() * table.cols() * sizeof(aicpp::real));
+
+    // Write to a temporary file and rename, so readers never observe a half-written cache
+    std::string tmp_path = cache_path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Could not create cache file: " << tmp_path << "\n";
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    for (const auto& name : column_names) {
+        uint32_t len = static_cast<uint32_t>(name.size());
+        out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.write(name.data(), len);
+    }
+    write_padding(out, h.data_offset - sizeof(CacheHeader) - h.names_bytes);
+
+    // Pack the rows into one row-major block, a slab of rows at a time, so the
+    // source may have either layout or a padded leading dimension
+    const size_t rows = table.rows(), cols = table.cols();
+    const size_t slab = 1 << 12;
+    std::vector<aicpp::real> buffer(std::min<size_t>(slab, rows) * cols);
+
+    for (size_t r0 = 0; r0 < rows; r0 += slab) {
+        size_t n = std::min(slab, rows - r0);
+        for (size_t r = 0; r < n; ++r) {
+            for (size_t j = 0; j < cols; ++j) buffer[r * cols + j] = table(r0 + r, j);
+        }
+        out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(n * cols * sizeof(aicpp::real)));
+    }
+    write_padding(out, h.labels_offset - h.data_offset - rows * cols * sizeof(aicpp::real));
+
+    if (h.has_labels) {
+        out.write(reinterpret_cast<const char*>(table.labels()),
+                  static_cast<std::streamsize>(rows * sizeof(aicpp::real)));
+        write_padding(out, align_up(rows * sizeof(aicpp::real)) - rows * sizeof(aicpp::real));
+    }
+
+    out.close();
+    if (!out || std::rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+        std::cerr << "Could not write cache file: " << cache_path << "\n";
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool DatasetCache::open(const std::string& cache_path, const std::string& source_csv,
+                        int label_col_index, char delimiter) {
+
+    close();
+
+    // A missing cache is the normal first-run case, so probe before mapping (which would log)
+    struct stat st;
+    if (::stat(cache_path.c_str(), &st) != 0) return false;
+    file_ = std::make_shared<MappedFile>();
+    if (!file_->open(cache_path)) { close(); return false; }
+
+    CacheHeader h;
+    if (file_->size() < sizeof(h)) { close(); return false; }
+    std::memcpy(&h, file_->data(), sizeof(h));
+
+    uint64_t src_size;
+    int64_t src_mtime;
+    bool valid = std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0
+        && h.version == kVersion && h.byte_order == kByteOrderMark
+        && h.value_type == kValueType
+        && h.label_col_index == label_col_index && h.delimiter == delimiter
+        && layout_fits(h, file_->size())
+        && source_identity(source_csv, src_size, src_mtime)
+        && src_size == h.source_size && src_mtime == h.source_mtime_ns;
+
+    if (!valid) { close(); return false; }
+
+    rows_ = h.rows;
+    cols_ = h.cols;
+
+    const char* p = file_->data() + sizeof(CacheHeader);
+    const char* names_end = p + h.names_bytes;
+    while (p + sizeof(uint32_t) <= names_end) {
+        uint32_t len;
+        std::memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        if (p + len > names_end) break;
+        names_.emplace_back(p, len);
+        p += len;
+    }
+
+    features_ = reinterpret_cast<const aicpp::real*>(file_->data() + h.data_offset);
+    if (h.has_labels) labels_ = reinterpret_cast<const aicpp::real*>(file_->data() + h.labels_offset);
+    return true;
+}
+
+bool DatasetCache::openOrBuild(const std::string& csv_path, int label_col_index, char delimiter) {
+
+    std::string cache_path = cachePathFor(csv_path);
+    if (open(cache_path, csv_path, label_col_index, delimiter)) return true;
+
+    aicpp::Dataset table;
+    if (!CSVParser::readNumericParallel(csv_path, table, label_col_index, delimiter)) return false;
+
+    if (!write(cache_path, table, read_header_names(csv_path, delimiter),
+               csv_path, label_col_index, delimiter)) return false;
+
+    return open(cache_path, csv_path, label_col_index, delimiter);
+}
+
+void DatasetCache::close() {
+    file_.reset();
+    rows_ = cols_ = 0;
+    features_ = nullptr;
+    labels_ = nullptr;
+    names_.clear();
+}
+
+aicpp::Dataset DatasetCache::view() const {
+
+    if (!is_open()) return aicpp::Dataset();
+    return aicpp::Dataset::view(features_, rows_, cols_, aicpp::Layout::RowMajor, labels_, file_);
+}
+
+void DatasetCache::gather_rows(size_t begin, size_t count, aicpp::Dataset& out) const {
+
+    begin = std::min(begin, rows_);
+    count = std::min(count, rows_ - begin);
+    out.resize(count, cols_);
+
+    std::copy(row(begin), row(begin + count), out.mutable_data());
+
+    if (labels_) std::copy(labels_ + begin, labels_ + begin + count, out.mutable_labels());
+}
+
+
+CacheStreamReader::CacheStreamReader(const DatasetCache& cache, size_t batch_rows)
+    : cache_(cache), batch_rows_(std::max<size_t>(batch_rows, 1)) {}
+
+bool CacheStreamReader::next_batch(aicpp::Dataset& batch) {
+
+    cache_.gather_rows(next_row_, batch_rows_, batch);
+    next_row_ += batch.rows();
+    return batch.rows() > 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/dataset.h"
+#include "dataset_stream.h"
+#include "mapped_file.h"
+
+
+/**
+ * Binary dataset cache.
+ *
+ * Layout: fixed header (schema, row count, source CSV identity), column names,
+ * then a 64-byte aligned row-major feature block followed by an aligned label
+ * block. Values are stored as aicpp::real (float32 or float64); a cache written
+ * with the other precision or an older layout is rebuilt. Opening a cache
+ * memory-maps it; view() serves the rows straight from the mapping, in the
+ * row-major layout the training and prediction APIs use, so they run without
+ * parsing or copying. A cache is stale (and rejected) when the source CSV's size
+ * or modification time differ from the recorded ones.
+ */
+class DatasetCache {
+public:
+    // Default cache location for a CSV file
+    static std::string cachePathFor(const std::string& csv_path);
+
+    // Writes table (plus header names) to cache_path, stamped with source_csv's identity
+    static bool write(const std::string& cache_path, const aicpp::Dataset& table,
+                      const std::vector<std::string>& column_names,
+                      const std::string& source_csv, int label_col_index, char delimiter = ',');
+
+    // Maps cache_path if it is valid and fresh for (source_csv, label_col_index, delimiter)
+    bool open(const std::string& cache_path, const std::string& source_csv,
+              int label_col_index, char delimiter = ',');
+
+    // Maps the cache next to csv_path, (re)building it from the CSV first when missing or stale
+    bool openOrBuild(const std::string& csv_path, int label_col_index, char delimiter = ',');
+
+    void close();
+    bool is_open() const { return file_ && file_->is_open(); }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    bool has_labels() const { return labels_ != nullptr; }
+
+    // Zero-copy views into the mapping: row r (cols() values) and the rows() labels
+    const aicpp::real* row(size_t r) const { return features_ + r * cols_; }
+    const aicpp::real* labels() const { return labels_; }
+    const std::vector<std::string>& column_names() const { return names_; }
+
+    // Zero-copy row-major Dataset over the mapping; it keeps the mapping alive
+    aicpp::Dataset view() const;
+
+    // Copies rows [begin, begin + count) into a batch
+    void gather_rows(size_t begin, size_t count, aicpp::Dataset& out) const;
+
+private:
+    std::shared_ptr<MappedFile> file_;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    const aicpp::real* features_ = nullptr;
+    const aicpp::real* labels_ = nullptr;
+    std::vector<std::string> names_;
+};
+
+// DatasetStream over an open DatasetCache; batches are copied from the mapped rows
+class CacheStreamReader : public DatasetStream {
+public:
+    CacheStreamReader(const DatasetCache& cache, size_t batch_rows);
+
+    bool next_batch(aicpp::Dataset& batch) override;
+    void rewind() override { next_row_ = 0; }
+
+    size_t cols() const override { return cache_.cols(); }
+    bool has_labels() const override { return cache_.has_labels(); }
+    size_t batch_rows() const override { return batch_rows_; }
+
+private:
+    const DatasetCache& cache_;
+    size_t batch_rows_;
+    size_t next_row_ = 0;
+};
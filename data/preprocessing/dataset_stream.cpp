@@ -0,0 +1,121 @@
+#include "dataset_stream.h"
+#include "csv_numeric.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using namespace csv_detail;
+
+namespace {
+const size_t kReadBlock = 1 << 20;
+}
+
+
+CSVStreamReader::CSVStreamReader(const std::string& filename, int label_col_index,
+                                 size_t batch_rows, char delimiter)
+    : filename_(filename), label_col_index_(label_col_index),
+      batch_rows_(std::max<size_t>(batch_rows, 1)), delimiter_(delimiter) {
+
+    buffer_.resize(kReadBlock);
+    rewind();
+}
+
+void CSVStreamReader::rewind() {
+
+    file_.close();
+    file_.clear();
+    file_.open(filename_, std::ios::binary);
+
+    pos_ = end_ = 0;
+    line_no_ = 0;
+    eof_ = false;
+    open_ = file_.is_open();
+
+    if (!open_) {
+        std::cerr << "Could not open file: " << filename_ << "\n";
+        return;
+    }
+
+    // Header row fixes the column count for every following batch
+    const char* line;
+    const char* eol;
+    if (!next_line(line, eol)) { num_cols_ = feature_cols_ = 0; return; }
+
+    num_cols_ = count_fields(line, eol, delimiter_);
+    if (num_cols_ == 0 || label_col_index_ >= static_cast<int>(num_cols_)) {
+        std::cerr << "Invalid header or label column in " << filename_ << "\n";
+        open_ = false;
+        return;
+    }
+    feature_cols_ = num_cols_ - (label_col_index_ >= 0 ? 1 : 0);
+}
+
+bool CSVStreamReader::refill() {
+
+    if (eof_) return false;
+
+    // Keep the unread tail and grow only when a single line exceeds the buffer
+    size_t tail = end_ - pos_;
+    if (pos_ > 0) std::memmove(buffer_.data(), buffer_.data() + pos_, tail);
+    pos_ = 0;
+    end_ = tail;
+    if (buffer_.size() - end_ < kReadBlock / 2) buffer_.resize(buffer_.size() * 2);
+
+    file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+    size_t got = static_cast<size_t>(file_.gcount());
+    end_ += got;
+
+    if (got == 0 || !file_) eof_ = true;
+    return got > 0;
+}
+
+bool CSVStreamReader::next_line(const char*& line, const char*& eol) {
+
+    while (true) {
+        const char* begin = buffer_.data() + pos_;
+        const char* end = buffer_.data() + end_;
+        const char* nl = find_eol(begin, end);
+
+        if (nl < end || (eof_ && begin < end)) {
+            line = begin;
+            eol = nl;
+            pos_ = static_cast<size_t>(nl - buffer_.data()) + (nl < end ? 1 : 0);
+            ++line_no_;
+            return true;
+        }
+        if (!refill() && eof_ && pos_ == end_) return false;
+    }
+}
+
+bool CSVStreamReader::next_batch(aicpp::Dataset& batch) {
+
+    if (!open_) {
+        batch.resize(0, feature_cols_);
+        return false;
+    }
+
+    batch.resize(batch_rows_, feature_cols_);
+    aicpp::real* features = batch.mutable_data();
+    aicpp::real* labels = has_labels() ? batch.mutable_labels() : nullptr;
+
+    size_t rows = 0;
+    const char* line;
+    const char* eol;
+    while (rows < batch_rows_ && next_line(line, eol)) {
+
+        if (!has_content(line, eol)) continue;
+
+        aicpp::real* f = features + rows * feature_cols_;
+        aicpp::real* l = labels ? labels + rows : nullptr;
+        size_t col = parse_numeric_line(line, eol, num_cols_, label_col_index_, delimiter_, f, l);
+        if (col != num_cols_) {
+            throw std::runtime_error("CSV parse error at line " + std::to_string(line_no_) +
+                                     ", column " + std::to_string(col + 1) + " of " + filename_);
+        }
+        ++rows;
+    }
+
+    batch.resize(rows, feature_cols_);
+    return rows > 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "core/dataset.h"
+
+
+// Source of fixed-size numeric row batches for out-of-core training.
+// A full pass ends when next_batch() returns false; rewind() starts the next epoch.
+class DatasetStream {
+public:
+    virtual ~DatasetStream() = default;
+
+    // Refills batch (row-major, reusing its buffer) with up to batch_rows() rows;
+    // returns false once the stream is exhausted
+    virtual bool next_batch(aicpp::Dataset& batch) = 0;
+
+    // Restarts the stream from its first row
+    virtual void rewind() = 0;
+
+    virtual size_t cols() const = 0;
+    virtual bool has_labels() const = 0;
+    virtual size_t batch_rows() const = 0;
+};
+
+// Streams a numeric CSV through a fixed-size read buffer; memory is O(batch_rows * cols)
+class CSVStreamReader : public DatasetStream {
+public:
+    CSVStreamReader(const std::string& filename, int label_col_index,
+                    size_t batch_rows, char delimiter = ',');
+
+    bool is_open() const { return open_; }
+
+    bool next_batch(aicpp::Dataset& batch) override;
+    void rewind() override;
+
+    size_t cols() const override { return feature_cols_; }
+    bool has_labels() const override { return label_col_index_ >= 0; }
+    size_t batch_rows() const override { return batch_rows_; }
+
+private:
+    // Returns the next complete line in [line, eol); false at end of file
+    bool next_line(const char*& line, const char*& eol);
+    bool refill();
+
+    std::string filename_;
+    std::ifstream file_;
+    int label_col_index_;
+    size_t batch_rows_;
+    char delimiter_;
+
+    size_t num_cols_ = 0;
+    size_t feature_cols_ = 0;
+    size_t line_no_ = 0;
+    bool open_ = false;
+    bool eof_ = false;
+
+    std::vector<char> buffer_;
+    size_t pos_ = 0;   // first unread byte in buffer_
+    size_t end_ = 0;   // one past the last valid byte in buffer_
+};
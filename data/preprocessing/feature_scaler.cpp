@@ -0,0 +1,221 @@
+#include "feature_scaler.h"
+#include "dataset_stream.h"
+#include "core/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+using aicpp::Dataset;
+using aicpp::Layout;
+
+namespace {
+
+const size_t kMinRowsPerChunk = 4096;
+
+// Welford update of `count` rows starting at x, where consecutive rows are `row_step`
+// apart and consecutive columns `col_step` apart
+void accumulate(const aicpp::real* x, size_t rows, size_t cols, size_t row_step, size_t col_step,
+                std::vector<FeatureScaler::ColumnStats>& stats) {
+
+    if (rows == 0) return;
+
+    std::vector<double> mean(cols), m2(cols, 0.0), minv(cols), maxv(cols);
+    for (size_t j = 0; j < cols; ++j) mean[j] = minv[j] = maxv[j] = x[j * col_step];
+
+    // Every column sees the same count, so 1/n is shared and the column loop vectorizes
+    for (size_t r = 1; r < rows; ++r) {
+        const aicpp::real* row = x + r * row_step;
+        double inv_n = 1.0 / static_cast<double>(r + 1);
+        for (size_t j = 0; j < cols; ++j) {
+            double v = row[j * col_step];
+            double delta = v - mean[j];
+            mean[j] += delta * inv_n;
+            m2[j] += delta * (v - mean[j]);
+            minv[j] = std::min(minv[j], v);
+            maxv[j] = std::max(maxv[j], v);
+        }
+    }
+
+    stats.assign(cols, FeatureScaler::ColumnStats());
+    for (size_t j = 0; j < cols; ++j) {
+        stats[j].count = rows;
+        stats[j].mean = mean[j];
+        stats[j].m2 = m2[j];
+        stats[j].min = minv[j];
+        stats[j].max = maxv[j];
+    }
+}
+
+} // namespace
+
+
+void FeatureScaler::ColumnStats::merge(const ColumnStats& other) {
+
+    if (other.count == 0) return;
+    if (count == 0) { *this = other; return; }
+
+    // Chan et al. pairwise combination of two Welford partials
+    double n_a = static_cast<double>(count), n_b = static_cast<double>(other.count);
+    double n = n_a + n_b;
+    double delta = other.mean - mean;
+
+    mean += delta * n_b / n;
+    m2 += other.m2 + delta * delta * n_a * n_b / n;
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+FeatureScaler::FeatureScaler(Method method) : method_(method) {}
+
+void FeatureScaler::fit(const Dataset& data) {
+    stats_.clear();
+    partial_fit(data);
+}
+
+void FeatureScaler::partial_fit(const Dataset& data) {
+
+    if (data.empty()) return;
+    if (!stats_.empty() && stats_.size() != data.cols()) {
+        throw std::runtime_error("Feature count does not match the fitted scaler.");
+    }
+
+    const size_t cols = data.cols();
+    const bool row_major = data.layout() == Layout::RowMajor;
+    const size_t row_step = row_major ? data.leading_dim() : 1;
+    const size_t col_step = row_major ? 1 : data.leading_dim();
+
+    size_t chunks = aicpp::parallel_chunks(data.rows(), kMinRowsPerChunk);
+    std::vector<std::vector<ColumnStats>> partial(chunks);
+
+    aicpp::parallel_for(data.rows(), kMinRowsPerChunk, [&](size_t chunk, size_t begin, size_t end) {
+        accumulate(data.data() + begin * row_step, end - begin, cols, row_step, col_step, partial[chunk]);
+    });
+
+    if (stats_.empty()) stats_.assign(cols, ColumnStats());
+    for (const auto& p : partial) {
+        for (size_t j = 0; j < p.size(); ++j) stats_[j].merge(p[j]);
+    }
+    update_parameters();
+}
+
+void FeatureScaler::fit(DatasetStream& stream) {
+
+    stats_.clear();
+    Dataset batch;
+
+    stream.rewind();
+    while (stream.next_batch(batch)) partial_fit(batch);
+}
+
+void FeatureScaler::update_parameters() {
+
+    offset_.resize(stats_.size());
+    scale_.resize(stats_.size());
+
+    for (size_t j = 0; j < stats_.size(); ++j) {
+        double spread = (method_ == Method::MinMax) ? stats_[j].max - stats_[j].min
+                                                    : std::sqrt(stats_[j].variance());
+        offset_[j] = static_cast<aicpp::real>((method_ == Method::MinMax) ? stats_[j].min : stats_[j].mean);
+        // Constant columns map to 0, as DataPreprocessor::normalize does
+        scale_[j] = static_cast<aicpp::real>(spread != 0.0 ? 1.0 / spread : 0.0);
+    }
+}
+
+void FeatureScaler::transform(Dataset& data) const {
+
+    if (data.empty()) return;
+    if (data.cols() != offset_.size()) throw std::runtime_error("Feature count does not match the fitted scaler.");
+
+    aicpp::real* base = data.mutable_data();
+    const size_t ld = data.leading_dim();
+    const aicpp::real* off = offset_.data();
+    const aicpp::real* sc = scale_.data();
+    const size_t cols = data.cols();
+
+    if (data.layout() == Layout::RowMajor) {
+        aicpp::parallel_for(data.rows(), kMinRowsPerChunk, [&](size_t, size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                aicpp::real* row = base + r * ld;
+                for (size_t j = 0; j < cols; ++j) row[j] = (row[j] - off[j]) * sc[j];
+            }
+        });
+    } else {
+        aicpp::parallel_for(cols, 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t j = begin; j < end; ++j) {
+                aicpp::real* col = base + j * ld;
+                const aicpp::real o = off[j], s = sc[j];
+                for (size_t r = 0; r < data.rows(); ++r) col[r] = (col[r] - o) * s;
+            }
+        });
+    }
+}
+
+void FeatureScaler::transform(aicpp::real* row) const {
+    for (size_t j = 0; j < offset_.size(); ++j) row[j] = (row[j] - offset_[j]) * scale_[j];
+}
+
+void FeatureScaler::transform(std::vector<aicpp::real>& row) const {
+    if (row.size() != offset_.size()) throw std::runtime_error("Feature count does not match the fitted scaler.");
+    transform(row.data());
+}
+
+void FeatureScaler::fit_transform(Dataset& data) {
+    fit(data);
+    transform(data);
+}
+
+bool FeatureScaler::save(const std::string& filename) const {
+
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Could not open file: " << filename << "\n";
+        return false;
+    }
+
+    out << "aicpp-scaler 1\n";
+    out << "method " << (method_ == Method::MinMax ? "minmax" : "zscore") << "\n";
+    out << "cols " << offset_.size() << "\n";
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (size_t j = 0; j < offset_.size(); ++j) out << offset_[j] << " " << scale_[j] << "\n";
+
+    return static_cast<bool>(out);
+}
+
+bool FeatureScaler::load(const std::string& filename) {
+
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        std::cerr << "Could not open file: " << filename << "\n";
+        return false;
+    }
+
+    std::string tag, method, key;
+    int version = 0;
+    size_t cols = 0;
+    in >> tag >> version >> key >> method;
+    if (tag != "aicpp-scaler" || version != 1 || key != "method" ||
+        (method != "minmax" && method != "zscore")) {
+        std::cerr << "Invalid scaler file: " << filename << "\n";
+        return false;
+    }
+    in >> key >> cols;
+
+    std::vector<aicpp::real> offset(cols), scale(cols);
+    for (size_t j = 0; j < cols; ++j) in >> offset[j] >> scale[j];
+    if (!in || key != "cols") {
+        std::cerr << "Invalid scaler file: " << filename << "\n";
+        return false;
+    }
+
+    // Serving only needs the parameters; the raw statistics stay with the training side
+    method_ = (method == "minmax") ? Method::MinMax : Method::ZScore;
+    offset_ = std::move(offset);
+    scale_ = std::move(scale);
+    stats_.clear();
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "core/dataset.h"
+
+class DatasetStream;
+
+// Reusable per-feature scaling: fit statistics once, then apply the same
+// transform to training, validation and serving inputs.
+class FeatureScaler {
+public:
+    enum class Method { MinMax, ZScore };
+
+    explicit FeatureScaler(Method method = Method::MinMax);
+
+    // Computes column statistics in one parallel pass (per-chunk Welford partials, merged)
+    void fit(const aicpp::Dataset& data);
+
+    // Merges another batch into the current statistics (streaming / incremental fit)
+    void partial_fit(const aicpp::Dataset& data);
+    void fit(DatasetStream& stream);
+
+    // x' = (x - offset) * scale, in place
+    void transform(aicpp::Dataset& data) const;
+    void transform(aicpp::real* row) const;
+    void transform(std::vector<aicpp::real>& row) const;
+    void fit_transform(aicpp::Dataset& data);
+
+    // Plain-text parameter file (method, column count, offsets, scales)
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+    bool fitted() const { return !offset_.empty(); }
+    Method method() const { return method_; }
+    size_t cols() const { return offset_.size(); }
+    const std::vector<aicpp::real>& offset() const { return offset_; }
+    const std::vector<aicpp::real>& scale() const { return scale_; }
+
+    // Mergeable per-column running statistics (always accumulated in double)
+    struct ColumnStats {
+        size_t count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;  // sum of squared deviations from the mean
+        double min = 0.0;
+        double max = 0.0;
+
+        void merge(const ColumnStats& other);
+        double variance() const { return count > 0 ? m2 / count : 0.0; }
+    };
+    const std::vector<ColumnStats>& stats() const { return stats_; }
+
+private:
+    void update_parameters();
+
+    Method method_;
+    std::vector<ColumnStats> stats_;
+    std::vector<aicpp::real> offset_;
+    std::vector<aicpp::real> scale_;
+};
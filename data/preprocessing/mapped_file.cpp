@@ -0,0 +1,76 @@
+#include "mapped_file.h"
+#include <iostream>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+MappedFile::MappedFile(const std::string& filename) {
+    open(filename);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      open_(std::exchange(other.open_, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        open_ = std::exchange(other.open_, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename) {
+
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Could not open file: " << filename << "\n";
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        std::cerr << "Could not stat file: " << filename << "\n";
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+
+    // mmap() rejects zero-length mappings; an empty file is still a valid (empty) view
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "Could not map file: " << filename << "\n";
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(p);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
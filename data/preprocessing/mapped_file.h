@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+
+// Read-only memory mapping of a whole file (RAII, move-only)
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the file; returns false (and prints the reason) on failure
+    bool open(const std::string& filename);
+    void close();
+
+    bool is_open() const { return open_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+};
@@ -0,0 +1,152 @@
+#include "sparse_parser.h"
+#include "csv_numeric.h"
+#include "dataset_stream.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace csv_detail;
+
+namespace {
+
+using index_type = aicpp::SparseMatrix::index_type;
+
+// Parses the content of one libsvm line [p, eol) (comment already stripped)
+bool libsvm_parse_line(const char* p, const char* eol, bool zero_based, aicpp::real& label,
+                       std::vector<index_type>& indices, std::vector<aicpp::real>& values) {
+
+    indices.clear();
+    values.clear();
+
+    p = parse_field(p, eol, label);
+    if (!p) return false;
+
+    unsigned long long next_index = 0;  // smallest index the next feature may use
+
+    while (p < eol) {
+
+        const char* token_end = p;
+        while (token_end < eol && !is_blank(*token_end)) ++token_end;
+
+        // Ranking query ids carry no feature
+        if (token_end - p >= 4 && std::equal(p, p + 4, "qid:")) {
+            p = token_end;
+            while (p < eol && is_blank(*p)) ++p;
+            continue;
+        }
+
+        unsigned long long index;
+        auto res = std::from_chars(p, token_end, index);
+        if (res.ec != std::errc() || res.ptr == token_end || *res.ptr != ':') return false;
+
+        if (!zero_based) {
+            if (index == 0) return false;
+            --index;
+        }
+        if (index > std::numeric_limits<index_type>::max()) return false;
+
+        aicpp::real value;
+        const char* next = parse_field(res.ptr + 1, token_end, value);
+        if (!next || next != token_end) return false;
+
+        if (index < next_index) return false;
+        next_index = index + 1;
+
+        // Explicit zeros are legal in the format but carry no information
+        if (value != 0) {
+            indices.push_back(static_cast<index_type>(index));
+            values.push_back(value);
+        }
+
+        p = token_end;
+        while (p < eol && is_blank(*p)) ++p;
+    }
+    return true;
+}
+
+} // namespace
+
+
+bool SparseParser::readLibSVM(const std::string& filename, aicpp::SparseMatrix& out,
+                              bool zero_based) {
+
+    out.clear();
+
+    MappedFile file;
+    if (!file.open(filename)) return false;
+
+    const char* p = file.data();
+    const char* end = p + file.size();
+
+    std::vector<index_type> indices;
+    std::vector<aicpp::real> values;
+    size_t line_no = 0;
+
+    while (p < end) {
+
+        const char* eol = find_eol(p, end);
+        ++line_no;
+
+        const char* content_end = std::find(p, eol, '#');
+
+        if (has_content(p, content_end)) {
+            aicpp::real label;
+            if (!libsvm_parse_line(p, content_end, zero_based, label, indices, values)) {
+                std::cerr << "LibSVM parse error at line " << line_no << "\n";
+                out.clear();
+                return false;
+            }
+            out.add_row(indices.data(), values.data(), indices.size(), label);
+        }
+
+        p = eol + 1;
+    }
+    return true;
+}
+
+bool SparseParser::readCSV(const std::string& filename, aicpp::SparseMatrix& out,
+                           int label_col_index, char delimiter) {
+
+    out.clear();
+
+    CSVStreamReader reader(filename, label_col_index, 4096, delimiter);
+    if (!reader.is_open()) return false;
+
+    out.set_cols(reader.cols());
+
+    aicpp::Dataset batch;
+    std::vector<index_type> indices;
+    std::vector<aicpp::real> values;
+
+    try {
+        while (reader.next_batch(batch)) {
+            for (size_t r = 0; r < batch.rows(); ++r) {
+
+                indices.clear();
+                values.clear();
+
+                const aicpp::real* row = batch.row_ptr(r);
+                for (size_t c = 0; c < batch.cols(); ++c) {
+                    if (row[c] != 0) {
+                        indices.push_back(static_cast<index_type>(c));
+                        values.push_back(row[c]);
+                    }
+                }
+
+                if (batch.has_labels()) out.add_row(indices.data(), values.data(), indices.size(), batch.label(r));
+                else out.add_row(indices.data(), values.data(), indices.size());
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << "\n";
+        out.clear();
+        return false;
+    }
+    return true;
+}
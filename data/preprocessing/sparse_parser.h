@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+#include "core/sparse_matrix.h"
+
+
+// Loaders that produce a CSR SparseMatrix, storing only the nonzero features
+class SparseParser {
+public:
+    // Reads a libsvm/svmlight file: "<label> <index>:<value> ...", indices strictly increasing.
+    // Indices are 1-based unless zero_based is set; "qid:" tokens and "#" comments are skipped.
+    // Returns false (and prints the offending line) on error.
+    static bool readLibSVM(const std::string& filename, aicpp::SparseMatrix& out,
+                           bool zero_based = false);
+
+    // Reads a numeric CSV (header row skipped) through a bounded-memory stream and keeps
+    // only its nonzero features. label_col_index < 0 = no labels.
+    static bool readCSV(const std::string& filename, aicpp::SparseMatrix& out,
+                        int label_col_index, char delimiter = ',');
+};
@@ -1,47 +1,244 @@
 #include "k_means_clusterer.h"
+#include "core/simd.h"
+#include "core/thread_pool.h"
+#include "data/preprocessing/dataset_stream.h"
 #include <algorithm>
 #include <limits>
 #include <random>
 #include <iostream>
+#include <stdexcept>
 #include <cmath>
 
 
 namespace aicpp {
 
-KMeansClusterer::KMeansClusterer(int k, int max_iters) :
-    K(k), MAX_ITERATIONS(max_iters) {}
+namespace {
+
+// Rows per block of the seeding distance passes. Block sums are reduced in block
+// order, so the sampled rows do not depend on how blocks are spread over threads.
+const size_t kSeedBlock = 4096;
+
+// k-means|| oversampling rounds, each picking about 2K candidates
+const int kParallelRounds = 5;
+
+[[noreturn]] void throw_non_finite_row() {
+    throw std::runtime_error("K-Means: a row has no finite distance to any centroid; "
+                             "check the data for NaN or overflowing values.");
+}
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Uniform [0, 1) draw for row i in a round: a per-row coin that no thread schedule can reorder
+double hashed_uniform(uint64_t round_seed, uint64_t i) {
+    return static_cast<double>(splitmix64(round_seed ^ splitmix64(i)) >> 11) * 0x1.0p-53;
+}
+
+// Mini-batch early stopping: steps without a relative improvement of the smoothed
+// batch inertia before training stops, and the weight of the newest batch in it
+const int kMaxNoImprovement = 10;
+const double kInertiaSmoothing = 0.1;
+
+struct InertiaMonitor {
+
+    double smoothed = -1.0;
+    double best = std::numeric_limits<double>::max();
+    int stale = 0;
+
+    // Folds in one batch's mean inertia; returns true once training should stop
+    bool update(double mean_inertia, double tolerance) {
+        smoothed = smoothed < 0.0 ? mean_inertia
+                                  : (1.0 - kInertiaSmoothing) * smoothed + kInertiaSmoothing * mean_inertia;
+        if (smoothed < best * (1.0 - tolerance)) {
+            best = smoothed;
+            stale = 0;
+        } else {
+            ++stale;
+        }
+        return stale >= kMaxNoImprovement;
+    }
+};
+
+// Minimum multiply-adds per parallel chunk; small datasets stay on one thread
+const size_t kMinWorkPerChunk = 1 << 15;
+
+// Rows handed to the distance engine at a time by the Lloyd assignment
+const size_t kAssignTile = 256;
+
+// Relative margin on bound arithmetic. It covers the rounding of a dim-term squared
+// distance in `real` precision, so a pruned centroid is always strictly farther.
+double bound_slack(size_t dim) {
+    return std::numeric_limits<real>::epsilon() * static_cast<double>(dim + 16);
+}
 
 /**
- * @brief Calculates the Euclidean distance between two feature vectors.
- * The formula is: d(p, q) = sqrt(sum((qi - pi)^2))
+ * @brief half_cc[i * K + j] = ½‖c_i − c_j‖ and s[i] = min over j ≠ i of half_cc[i * K + j],
+ * both rounded down by `slack`.
  */
-double KMeansClusterer::euclidean_distance(const std::vector<double>& p1, const std::vector<double>& p2) const {
+void half_center_distances(const std::vector<std::vector<real>>& centers, double slack,
+                           std::vector<double>& half_cc, std::vector<double>& s) {
+
+    const size_t k = centers.size(), dim = centers.empty() ? 0 : centers[0].size();
+    half_cc.assign(k * k, 0.0);
+    s.assign(k, std::numeric_limits<double>::max());
 
-    if (p1.size() != p2.size()) {
-        std::cerr << "Error: Vectors must have the same dimension for distance calculation." << std::endl;
-        return std::numeric_limits<double>::max();
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t j = i + 1; j < k; ++j) {
+            double h = 0.5 * std::sqrt(simd::squared_l2(centers[i].data(), centers[j].data(), dim)) * (1.0 - slack);
+            half_cc[i * k + j] = half_cc[j * k + i] = h;
+            s[i] = std::min(s[i], h);
+            s[j] = std::min(s[j], h);
+        }
     }
+}
 
-    double sum_sq = 0.0;
-    for (size_t i = 0; i < p1.size(); ++i) {
-        sum_sq += std::pow(p1[i] - p2[i], 2);
+const char* init_name(KMeansClusterer::Init init) {
+    switch (init) {
+        case KMeansClusterer::Init::KMeansPlusPlus: return "k-means++";
+        case KMeansClusterer::Init::KMeansParallel: return "k-means||";
+        default:                                    return "random";
     }
-    return std::sqrt(sum_sq);
 }
 
 /**
- * @brief Initializes centroids by randomly selecting K data points from the dataset.
+ * @brief Lowers min_d2[r] to the squared distance from row r to each of
+ * centers[first, last), recording the closest center index in `nearest` when given.
+ * Fills block_sums with Σ min_d2 per kSeedBlock rows and returns their total.
  */
- void KMeansClusterer::initialize_centroids(const std::vector<DataPoint>& data) {
-    
+double update_min_distances(const Dataset& rows, const std::vector<std::vector<real>>& centers,
+                            size_t first, size_t last, std::vector<double>& min_d2,
+                            std::vector<int>* nearest, std::vector<double>& block_sums) {
+
+    const size_t n = rows.rows(), dim = rows.cols();
+    const size_t blocks = (n + kSeedBlock - 1) / kSeedBlock;
+    block_sums.assign(blocks, 0.0);
+
+    parallel_for(blocks, 1, [&](size_t, size_t b0, size_t b1) {
+        for (size_t b = b0; b < b1; ++b) {
+
+            double sum = 0.0;
+            for (size_t r = b * kSeedBlock; r < std::min(n, (b + 1) * kSeedBlock); ++r) {
+
+                const real* x = rows.row_ptr(r);
+                for (size_t c = first; c < last; ++c) {
+                    double d = simd::squared_l2(x, centers[c].data(), dim);
+                    if (d < min_d2[r]) {
+                        min_d2[r] = d;
+                        if (nearest) (*nearest)[r] = static_cast<int>(c);
+                    }
+                }
+                sum += min_d2[r];
+            }
+            block_sums[b] = sum;
+        }
+    });
+
+    double total = 0.0;
+    for (double s : block_sums) total += s;
+    return total;
+}
+
+/**
+ * @brief Total cost Σ min(min_d2[r], ‖row r - center‖²) if `center` were added.
+ */
+double cost_with_center(const Dataset& rows, const real* center, const std::vector<double>& min_d2) {
+
+    const size_t n = rows.rows(), dim = rows.cols();
+    const size_t blocks = (n + kSeedBlock - 1) / kSeedBlock;
+    std::vector<double> block_sums(blocks, 0.0);
+
+    parallel_for(blocks, 1, [&](size_t, size_t b0, size_t b1) {
+        for (size_t b = b0; b < b1; ++b) {
+            double sum = 0.0;
+            for (size_t r = b * kSeedBlock; r < std::min(n, (b + 1) * kSeedBlock); ++r) {
+                sum += std::min<double>(min_d2[r], simd::squared_l2(rows.row_ptr(r), center, dim));
+            }
+            block_sums[b] = sum;
+        }
+    });
+
+    double total = 0.0;
+    for (double s : block_sums) total += s;
+    return total;
+}
+
+/**
+ * @brief Index drawn with probability weight[i] / total, where block_sums holds the
+ * weight sums of consecutive `block`-sized ranges; u is uniform in [0, 1).
+ */
+size_t sample_weighted(const std::vector<double>& weight, const std::vector<double>& block_sums,
+                       size_t block, double total, double u) {
+
+    double target = u * total;
+    size_t b = 0;
+    while (b + 1 < block_sums.size() && target >= block_sums[b]) target -= block_sums[b++];
+
+    size_t last = b * block;
+    for (size_t i = b * block; i < std::min(weight.size(), (b + 1) * block); ++i) {
+        if (weight[i] <= 0.0) continue;
+        if (target < weight[i]) return i;
+        target -= weight[i];
+        last = i;
+    }
+    return last;  // rounding carried target past the block's last positive weight
+}
+
+} // namespace
+
+KMeansClusterer::KMeansClusterer(int k, int max_iters, Init init, Algorithm algorithm) :
+    K(k), MAX_ITERATIONS(max_iters), init_(init), algorithm_(algorithm) {}
+
+void KMeansClusterer::set_seed(uint64_t seed) {
+    has_seed_ = true;
+    seed_ = seed;
+}
+
+void KMeansClusterer::set_mini_batch(size_t batch_size, double tolerance) {
+    batch_size_ = batch_size;
+    tolerance_ = tolerance;
+}
+
+void KMeansClusterer::set_n_init(int n_init) {
+    n_init_ = std::max(1, n_init);
+}
+
+std::mt19937_64 KMeansClusterer::make_rng() const {
+    return std::mt19937_64(has_seed_ ? seed_ : std::random_device{}());
+}
+
+/**
+ * @brief Squared Euclidean distance between two dim-length rows (no sqrt).
+ */
+real KMeansClusterer::squared_distance(const real* p1, const real* p2, size_t dim) const {
+    return simd::squared_l2(p1, p2, dim);
+}
+
+/**
+ * @brief Seeds the centroids with the configured Init method.
+ */
+void KMeansClusterer::initialize_centroids(const Dataset& data) {
+
     if (data.empty()) return;
-    
-    // Use a random number generator
-    std::random_device rd;
-    std::mt19937 g(rd());
 
-    // Generate indices from 0 to data.size() - 1
-    std::vector<size_t> indices(data.size());
+    std::mt19937_64 rng = make_rng();
+    switch (init_) {
+        case Init::KMeansPlusPlus: seed_plus_plus(data, rng); break;
+        case Init::KMeansParallel: seed_parallel(data, rng); break;
+        default:                   seed_random(data, rng); break;
+    }
+}
+
+/**
+ * @brief Initializes centroids by randomly selecting K data points from the dataset.
+ */
+void KMeansClusterer::seed_random(const Dataset& data, std::mt19937_64& g) {
+
+    // Generate indices from 0 to data.rows() - 1
+    std::vector<size_t> indices(data.rows());
     std::iota(indices.begin(), indices.end(), 0);
 
     // Randomly shuffle the indices
@@ -50,8 +247,9 @@ double KMeansClusterer::euclidean_distance(const std::vector<double>& p1, const
     // Clear existing centroids and select the first K unique points
     centroids.clear();
     for (int i = 0; i < K; ++i) {
-        if (i < data.size()) {
-            centroids.push_back(data[indices[i]].features);
+        if (static_cast<size_t>(i) < data.rows()) {
+            const real* row = data.row_ptr(indices[i]);
+            centroids.emplace_back(row, row + data.cols());
         } else {
             // Should not happen if data size >= K, but good safety check
             std::cerr << "Warning: Cannot initialize K centroids, dataset too small." << std::endl;
@@ -61,67 +259,467 @@ double KMeansClusterer::euclidean_distance(const std::vector<double>& p1, const
 }
 
 /**
- * @brief Assignment step: Assigns each data point to the closest centroid.
+ * @brief Greedy k-means++ (D² sampling): each step draws 2 + ln K rows with
+ * probability proportional to their squared distance to the nearest centroid,
+ * and keeps the one that lowers the total cost most.
  */
-void KMeansClusterer::assign_clusters(std::vector<DataPoint>& data) {
+void KMeansClusterer::seed_plus_plus(const Dataset& data, std::mt19937_64& rng) {
 
-    for (auto& point : data) {
+    const size_t n = data.rows();
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<size_t> any_row(0, n - 1);
 
-        double min_dist = std::numeric_limits<double>::max();
-        int best_cluster_id = -1;
-
-        // Compare the point to every centroid
-        for (size_t i = 0; i < centroids.size(); ++i) {
-            
-            double dist = euclidean_distance(point.features, centroids[i]);
-            if (dist < min_dist) {
-                min_dist = dist;
-                best_cluster_id = (int)i;
+    std::vector<double> min_d2(n, std::numeric_limits<double>::max());
+    std::vector<double> block_sums;
+    const int trials = 2 + static_cast<int>(std::log(static_cast<double>(K)));
+
+    centroids.clear();
+    const real* first = data.row_ptr(any_row(rng));
+    centroids.emplace_back(first, first + data.cols());
+
+    while (centroids.size() < static_cast<size_t>(K)) {
+
+        double total = update_min_distances(data, centroids, centroids.size() - 1, centroids.size(),
+                                            min_d2, nullptr, block_sums);
+
+        // total is 0 only when every row coincides with a centroid already
+        size_t next = total > 0.0 ? sample_weighted(min_d2, block_sums, kSeedBlock, total, unit(rng))
+                                  : any_row(rng);
+
+        if (total > 0.0) {
+            double best_cost = cost_with_center(data, data.row_ptr(next), min_d2);
+            for (int t = 1; t < trials; ++t) {
+                size_t candidate = sample_weighted(min_d2, block_sums, kSeedBlock, total, unit(rng));
+                double cost = cost_with_center(data, data.row_ptr(candidate), min_d2);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    next = candidate;
+                }
             }
         }
-        point.cluster_id = best_cluster_id;
+
+        const real* row = data.row_ptr(next);
+        centroids.emplace_back(row, row + data.cols());
     }
 }
 
 /**
- * @brief Update step: Recalculates the centroid positions based on assigned points.
- * @return true if centroids moved (indicating non-convergence), false otherwise.
+ * @brief k-means|| (Bahmani et al.): each round keeps every row independently with
+ * probability min(1, 2K·d²/φ), where φ is the current total cost. After the rounds,
+ * every candidate is weighted by the number of rows closest to it, and greedy
+ * weighted k-means++ reduces the candidates to K centroids.
  */
-bool KMeansClusterer::update_centroids(const std::vector<DataPoint>& data) {
+void KMeansClusterer::seed_parallel(const Dataset& data, std::mt19937_64& rng) {
 
-    // Stores the sum of feature vectors and the count of points for each cluster
-    std::vector<std::vector<double>> new_centroids_sum(K, std::vector<double>(centroids[0].size(), 0.0));
-    std::vector<int> cluster_counts(K, 0);
+    const size_t n = data.rows(), dim = data.cols();
+    const size_t blocks = (n + kSeedBlock - 1) / kSeedBlock;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<size_t> any_row(0, n - 1);
 
-    // 1. Sum up all features for points in each cluster
-    for (const auto& point : data) {
-        
-        int id = point.cluster_id;
+    std::vector<std::vector<real>> candidates;
+    const real* first = data.row_ptr(any_row(rng));
+    candidates.emplace_back(first, first + dim);
+
+    std::vector<double> min_d2(n, std::numeric_limits<double>::max());
+    std::vector<int> nearest(n, 0);
+    std::vector<double> block_sums;
+    double phi = update_min_distances(data, candidates, 0, 1, min_d2, &nearest, block_sums);
+
+    const double oversample = 2.0 * K;
+    std::vector<std::vector<size_t>> picked(blocks);
+
+    for (int round = 0; round < kParallelRounds && phi > 0.0; ++round) {
+
+        const uint64_t round_seed = rng();
+        parallel_for(blocks, 1, [&](size_t, size_t b0, size_t b1) {
+            for (size_t b = b0; b < b1; ++b) {
+                picked[b].clear();
+                for (size_t r = b * kSeedBlock; r < std::min(n, (b + 1) * kSeedBlock); ++r) {
+                    if (hashed_uniform(round_seed, r) * phi < oversample * min_d2[r]) picked[b].push_back(r);
+                }
+            }
+        });
+
+        const size_t added_from = candidates.size();
+        for (const auto& rows : picked) {
+            for (size_t r : rows) candidates.emplace_back(data.row_ptr(r), data.row_ptr(r) + dim);
+        }
+        if (candidates.size() == added_from) continue;
+
+        phi = update_min_distances(data, candidates, added_from, candidates.size(), min_d2, &nearest, block_sums);
+    }
+
+    // Fewer candidates than K: the data has fewer distinct rows; pad with random rows
+    centroids.clear();
+    if (candidates.size() <= static_cast<size_t>(K)) {
+        centroids = std::move(candidates);
+        while (centroids.size() < static_cast<size_t>(K)) {
+            const real* row = data.row_ptr(any_row(rng));
+            centroids.emplace_back(row, row + dim);
+        }
+        return;
+    }
+
+    // Greedy weighted k-means++ over the candidates (each is nearest to at least itself)
+    const size_t m = candidates.size();
+    std::vector<double> weight(m, 0.0);
+    for (size_t r = 0; r < n; ++r) weight[nearest[r]] += 1.0;
+
+    const int trials = 2 + static_cast<int>(std::log(static_cast<double>(K)));
+    std::vector<double> cand_d2(m, std::numeric_limits<double>::max());
+    std::vector<double> score(weight);
+    double total = static_cast<double>(n);
+
+    auto weighted_cost = [&](size_t c) {
+        double cost = 0.0;
+        for (size_t i = 0; i < m; ++i) {
+            cost += weight[i] * std::min<double>(cand_d2[i], simd::squared_l2(candidates[i].data(),
+                                                                               candidates[c].data(), dim));
+        }
+        return cost;
+    };
+
+    while (true) {
+
+        size_t next = sample_weighted(score, { total }, m, total, unit(rng));
+        if (!centroids.empty()) {
+            double best_cost = weighted_cost(next);
+            for (int t = 1; t < trials; ++t) {
+                size_t candidate = sample_weighted(score, { total }, m, total, unit(rng));
+                double cost = weighted_cost(candidate);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    next = candidate;
+                }
+            }
+        }
+
+        centroids.push_back(candidates[next]);
+        if (centroids.size() == static_cast<size_t>(K)) break;
+
+        total = 0.0;
+        for (size_t i = 0; i < m; ++i) {
+            cand_d2[i] = std::min<double>(cand_d2[i], simd::squared_l2(candidates[i].data(),
+                                                                       centroids.back().data(), dim));
+            score[i] = weight[i] * cand_d2[i];
+            total += score[i];
+        }
+    }
+}
+
+/**
+ * @brief Initializes centroids with a reservoir sample of K rows from one pass over the stream.
+ */
+void KMeansClusterer::initialize_centroids(DatasetStream& stream) {
+
+    std::mt19937_64 g = make_rng();
+
+    centroids.clear();
+    size_t seen = 0;
+    Dataset batch;
+
+    stream.rewind();
+    while (stream.next_batch(batch)) {
+        for (size_t r = 0; r < batch.rows(); ++r, ++seen) {
+
+            const real* row = batch.row_ptr(r);
+            if (seen < static_cast<size_t>(K)) {
+                centroids.emplace_back(row, row + batch.cols());
+                continue;
+            }
+            std::uniform_int_distribution<size_t> pick(0, seen);
+            size_t slot = pick(g);
+            if (slot < static_cast<size_t>(K)) centroids[slot].assign(row, row + batch.cols());
+        }
+    }
+}
+
+/**
+ * @brief Sizes the per-chunk buffers for passes split into `chunks` ranges.
+ */
+void KMeansClusterer::Accumulators::resize(size_t chunks, size_t k, size_t d) {
+    dim = d;
+    sums.assign(chunks, std::vector<double>(k * d, 0.0));
+    counts.assign(chunks, std::vector<size_t>(k, 0));
+    evaluations.assign(chunks, 0);
+    inertia.assign(chunks, 0.0);
+}
+
+void KMeansClusterer::Accumulators::reset() {
+    for (auto& s : sums) std::fill(s.begin(), s.end(), 0.0);
+    for (auto& c : counts) std::fill(c.begin(), c.end(), 0);
+    std::fill(evaluations.begin(), evaluations.end(), 0);
+    std::fill(inertia.begin(), inertia.end(), 0.0);
+}
+
+void KMeansClusterer::Accumulators::add(size_t chunk, int id, const real* x) {
+
+    // The distance searches return -1 when no distance compares below the initial
+    // maximum, i.e. the row holds NaN or its distances overflow
+    if (id < 0 || static_cast<size_t>(id) >= counts[chunk].size()) throw_non_finite_row();
+    counts[chunk][id]++;
+    simd::multiply_accumulate(1.0, x, sums[chunk].data() + id * dim, dim);
+}
+
+/**
+ * @brief Rows per parallel chunk, so that each chunk does at least kMinWorkPerChunk
+ * multiply-adds of distance work; every pass of one train() call splits rows the same way.
+ */
+size_t KMeansClusterer::min_rows_per_chunk(size_t dim) const {
+    return std::max<size_t>(1, kMinWorkPerChunk / std::max<size_t>(1, K * dim));
+}
+
+/**
+ * @brief Assignment step: Assigns each data point to the closest centroid. Rows go
+ * through the blocked GEMM distance engine in tiles, split across the thread pool,
+ * and each chunk adds its rows to its own accumulators when given. cluster_ids may
+ * be null (streamed batches).
+ */
+void KMeansClusterer::assign_clusters(const Dataset& data, int* cluster_ids, Accumulators* acc) {
+
+    const size_t dim = data.cols();
+    search_.assign(centroids);
+
+    parallel_for(data.rows(), min_rows_per_chunk(dim), [&](size_t chunk, size_t begin, size_t end) {
+
+        int labels[kAssignTile];
+        double distances[kAssignTile];
+        double inertia = 0.0;
+        for (size_t r0 = begin; r0 < end; r0 += kAssignTile) {
+
+            const size_t m = std::min(kAssignTile, end - r0);
+            search_.nearest(data.row_ptr(r0), m, data.leading_dim(), labels, distances);
+
+            for (size_t i = 0; i < m; ++i) {
+                if (cluster_ids) cluster_ids[r0 + i] = labels[i];
+                if (acc) {
+                    acc->add(chunk, labels[i], data.row_ptr(r0 + i));
+                    inertia += distances[i];
+                }
+            }
+        }
+        if (acc) acc->inertia[chunk] += inertia;
+    });
+    distance_evaluations_ += data.rows() * centroids.size();
+}
+
+/**
+ * @brief Hamerly's assignment: a point keeps its centroid without any distance
+ * computation while its upper bound is below both its lower bound (to the second
+ * closest centroid) and half the gap to its centroid's nearest neighbour.
+ */
+void KMeansClusterer::assign_hamerly(const Dataset& data, std::vector<int>& cluster_ids,
+                                     Bounds& bounds, bool first, Accumulators& acc) {
+
+    const size_t n = data.rows(), dim = data.cols(), k = centroids.size();
+    const double slack = bound_slack(dim);
+
+    if (first) {
+        bounds.upper.assign(n, 0.0);
+        bounds.lower.assign(n, 0.0);
+    }
+
+    // Bounds shift by how far the centroids moved
+    size_t fastest = 0;
+    double max_drift = 0.0, second_drift = 0.0;
+    for (size_t c = 0; !first && c < k; ++c) {
+        if (drift_[c] > max_drift) {
+            second_drift = max_drift;
+            max_drift = drift_[c];
+            fastest = c;
+        } else if (drift_[c] > second_drift) {
+            second_drift = drift_[c];
+        }
+    }
+
+    std::vector<double> half_cc, s;
+    if (!first) half_center_distances(centroids, slack, half_cc, s);
+
+    parallel_for(n, min_rows_per_chunk(dim), [&](size_t chunk, size_t begin, size_t end) {
+
+        size_t evaluations = 0;
+
+        for (size_t r = begin; r < end; ++r) {
+
+            const real* point = data.row_ptr(r);
+
+            if (!first) {
+                const int a = cluster_ids[r];
+                bounds.upper[r] += drift_[a] * (1.0 + slack);
+                bounds.lower[r] -= (static_cast<size_t>(a) == fastest ? second_drift : max_drift) * (1.0 + slack);
+
+                const double m = std::max(s[a], bounds.lower[r]);
+                if (bounds.upper[r] < m) {
+                    acc.add(chunk, a, point);
+                    continue;
+                }
+
+                // Tighten the upper bound before falling back to a full scan
+                double da = squared_distance(point, centroids[a].data(), dim);
+                ++evaluations;
+                bounds.upper[r] = std::sqrt(da) * (1.0 + slack);
+                if (bounds.upper[r] < m) {
+                    acc.add(chunk, a, point);
+                    continue;
+                }
+            }
+
+            // Full scan, in Lloyd's order and with Lloyd's tie-break
+            double best = std::numeric_limits<double>::max(), second = best;
+            int best_id = -1;
+            for (size_t c = 0; c < k; ++c) {
+                double d = squared_distance(point, centroids[c].data(), dim);
+                if (d < best) {
+                    second = best;
+                    best = d;
+                    best_id = static_cast<int>(c);
+                } else if (d < second) {
+                    second = d;
+                }
+            }
+            evaluations += k;
+
+            cluster_ids[r] = best_id;
+            bounds.upper[r] = std::sqrt(best) * (1.0 + slack);
+            bounds.lower[r] = std::sqrt(second) * (1.0 - slack);
+            acc.add(chunk, best_id, point);
+        }
+        acc.evaluations[chunk] += evaluations;
+    });
+}
+
+/**
+ * @brief Elkan's assignment: with a lower bound per (point, centroid) and the
+ * centroid-centroid distances, a centroid is only measured when neither bound
+ * proves it farther than the point's current centroid.
+ */
+void KMeansClusterer::assign_elkan(const Dataset& data, std::vector<int>& cluster_ids,
+                                   Bounds& bounds, bool first, Accumulators& acc) {
+
+    const size_t n = data.rows(), dim = data.cols(), k = centroids.size();
+    const double slack = bound_slack(dim);
+
+    if (first) {
+        bounds.upper.assign(n, 0.0);
+        bounds.lower.assign(n * k, 0.0);
+    }
+
+    std::vector<double> half_cc, s;
+    if (!first) half_center_distances(centroids, slack, half_cc, s);
+
+    parallel_for(n, min_rows_per_chunk(dim), [&](size_t chunk, size_t begin, size_t end) {
+
+        size_t evaluations = 0;
+
+        for (size_t r = begin; r < end; ++r) {
+
+            const real* point = data.row_ptr(r);
+            double* lower = bounds.lower.data() + r * k;
+
+            if (first) {
 
-        if (id >= 0 && id < K) {
-            cluster_counts[id]++;
-            for (size_t i = 0; i < point.features.size(); ++i) {
-                new_centroids_sum[id][i] += point.features[i];
+                double best = std::numeric_limits<double>::max();
+                int best_id = -1;
+
+                for (size_t c = 0; c < k; ++c) {
+                    double d = squared_distance(point, centroids[c].data(), dim);
+                    lower[c] = std::sqrt(d) * (1.0 - slack);
+                    if (d < best) {
+                        best = d;
+                        best_id = static_cast<int>(c);
+                    }
+                }
+                evaluations += k;
+
+                cluster_ids[r] = best_id;
+                bounds.upper[r] = std::sqrt(best) * (1.0 + slack);
+                acc.add(chunk, best_id, point);
+                continue;
             }
+
+            for (size_t c = 0; c < k; ++c) lower[c] = std::max(0.0, lower[c] - drift_[c] * (1.0 + slack));
+
+            size_t a = cluster_ids[r];
+            double u = bounds.upper[r] + drift_[a] * (1.0 + slack);
+
+            if (u >= s[a]) {
+
+                double da = 0.0;
+                bool stale = true;
+
+                for (size_t c = 0; c < k; ++c) {
+
+                    if (c == a || u < lower[c] || u < half_cc[a * k + c]) continue;
+
+                    if (stale) {
+                        da = squared_distance(point, centroids[a].data(), dim);
+                        ++evaluations;
+                        u = std::sqrt(da) * (1.0 + slack);
+                        lower[a] = std::sqrt(da) * (1.0 - slack);
+                        stale = false;
+                        if (u < lower[c] || u < half_cc[a * k + c]) continue;
+                    }
+
+                    double dc = squared_distance(point, centroids[c].data(), dim);
+                    ++evaluations;
+                    lower[c] = std::sqrt(dc) * (1.0 - slack);
+
+                    // Lloyd keeps the lowest index among equal distances
+                    if (dc < da || (dc == da && c < a)) {
+                        a = c;
+                        da = dc;
+                        u = std::sqrt(dc) * (1.0 + slack);
+                    }
+                }
+            }
+
+            cluster_ids[r] = static_cast<int>(a);
+            bounds.upper[r] = u;
+            acc.add(chunk, static_cast<int>(a), point);
         }
+        acc.evaluations[chunk] += evaluations;
+    });
+}
+
+/**
+ * @brief Update step: reduces the per-chunk sums into the first chunk and moves
+ * every centroid to the mean of its points, in place. Records each centroid's
+ * drift and the pass's distance count.
+ * @return true if centroids moved (indicating non-convergence), false otherwise.
+ */
+bool KMeansClusterer::update_centroids(Accumulators& acc) {
+
+    const size_t dim = acc.dim;
+    std::vector<double>& sums = acc.sums[0];
+    std::vector<size_t>& counts = acc.counts[0];
+
+    for (size_t c = 1; c < acc.sums.size(); ++c) {
+        for (size_t i = 0; i < sums.size(); ++i) sums[i] += acc.sums[c][i];
+        for (int i = 0; i < K; ++i) counts[i] += acc.counts[c][i];
     }
+    for (size_t e : acc.evaluations) distance_evaluations_ += e;
+    inertia_ = 0.0;
+    for (double d : acc.inertia) inertia_ += d;
 
-    // 2. Calculate the mean (average)
-    std::vector<std::vector<double>> old_centroids = centroids;
     bool moved = false;
-    double convergence_threshold = 1e-6; 
+    const double convergence_threshold = 1e-6;
+    drift_.resize(K);
 
     for (int i = 0; i < K; ++i) {
-        if (cluster_counts[i] > 0) {
-            for (size_t j = 0; j < centroids[i].size(); ++j) {
-                centroids[i][j] = new_centroids_sum[i][j] / cluster_counts[i];
+
+        double moved_sq = 0.0;
+        if (counts[i] > 0) {
+            for (size_t j = 0; j < dim; ++j) {
+                const real mean = static_cast<real>(sums[i * dim + j] / counts[i]);
+                const double delta = static_cast<double>(mean) - centroids[i][j];
+                moved_sq += delta * delta;
+                centroids[i][j] = mean;
             }
         }
-        
-        // 3. Check for movement (convergence)
-        if (euclidean_distance(centroids[i], old_centroids[i]) > convergence_threshold) {
-            moved = true;
-        }
+
+        // Check for movement (convergence)
+        drift_[i] = std::sqrt(moved_sq);
+        if (drift_[i] > convergence_threshold) moved = true;
     }
 
     return moved;
@@ -130,25 +728,182 @@ bool KMeansClusterer::update_centroids(const std::vector<DataPoint>& data) {
 /**
  * @brief Main training loop for K-Means.
  */
-
 void KMeansClusterer::train(std::vector<DataPoint>& data) {
+
+    Dataset ds = Dataset::from_points(data);
+    train(ds);
+
+    for (size_t r = 0; r < data.size(); ++r) data[r].cluster_id = ds.cluster_ids()[r];
+}
+
+void KMeansClusterer::train(Dataset& data) {
     
-    if (data.size() < K || data.empty()) {
+    if (data.rows() < static_cast<size_t>(K) || data.empty()) {
         std::cerr << "Error: Dataset size is insufficient for K-Means with K=" << K << std::endl;
         return;
     }
-    
+    if (batch_size_ > 0 && batch_size_ < data.rows()) {
+        train_mini_batch(data);
+        return;
+    }
+
+    const Dataset rows = data.as_row_major();
+    std::vector<int>& cluster_ids = data.cluster_ids();
+
+    if (n_init_ <= 1) {
+        fit(rows, cluster_ids);
+        return;
+    }
+
+    std::cout << "--- K-Means Training Started (K=" << K << ", init=" << init_name(init_)
+              << ", n_init=" << n_init_ << ") ---" << std::endl;
+
+    // Independent restarts share the read-only rows; passes inside a restart run inline
+    std::vector<KMeansClusterer> trials(n_init_, *this);
+    std::vector<uint64_t> seeds(n_init_);
+    std::random_device rd;
+    for (int i = 0; i < n_init_; ++i) seeds[i] = has_seed_ ? seed_ + i : rd();
+
+    ThreadPool::instance().run(n_init_, [&](size_t i) {
+        KMeansClusterer& trial = trials[i];
+        trial.n_init_ = 1;
+        trial.verbose_ = false;
+        trial.set_seed(seeds[i]);
+        std::vector<int> ids(rows.rows());
+        trial.fit(rows, ids);
+    });
+
+    size_t best = 0;
+    size_t evaluations = 0;
+    for (int i = 0; i < n_init_; ++i) {
+        std::cout << "Restart " << i + 1 << ": " << trials[i].iterations_ << " iterations, inertia "
+                  << trials[i].inertia_ << std::endl;
+        if (trials[i].inertia_ < trials[best].inertia_) best = i;
+        evaluations += trials[i].distance_evaluations_;
+    }
+    std::cout << "K-Means kept restart " << best + 1 << " (lowest inertia)." << std::endl;
+
+    centroids = std::move(trials[best].centroids);
+    iterations_ = trials[best].iterations_;
+    distance_evaluations_ = evaluations;
+    inertia_ = compute_inertia(rows, cluster_ids.data());
+}
+
+/**
+ * @brief One full-batch run (seeding plus Lloyd, Hamerly or Elkan iterations);
+ * ends with an exact pass that sets the final labels and inertia_.
+ */
+double KMeansClusterer::fit(const Dataset& rows, std::vector<int>& cluster_ids) {
+
     // Step 1: Initialization
-    initialize_centroids(data);
-    std::cout << "--- K-Means Training Started (K=" << K << ") ---" << std::endl;
+    initialize_centroids(rows);
+    distance_evaluations_ = 0;
+    Bounds bounds;
+    if (verbose_) {
+        std::cout << "--- K-Means Training Started (K=" << K << ", init=" << init_name(init_) << ") ---" << std::endl;
+    }
+
+    // Allocated once; every iteration reuses the same per-chunk buffers
+    Accumulators acc;
+    acc.resize(parallel_chunks(rows.rows(), min_rows_per_chunk(rows.cols())), K, rows.cols());
 
     for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
         
-        // Step 2: Assignment
-        assign_clusters(data);
+        // Step 2: Assignment fused with the per-chunk centroid sums
+        acc.reset();
+        switch (algorithm_) {
+            case Algorithm::Hamerly: assign_hamerly(rows, cluster_ids, bounds, iter == 0, acc); break;
+            case Algorithm::Elkan:   assign_elkan(rows, cluster_ids, bounds, iter == 0, acc); break;
+            default:                 assign_clusters(rows, cluster_ids.data(), &acc); break;
+        }
 
         // Step 3: Update and Check for Convergence
-        bool moved = update_centroids(data);
+        bool moved = update_centroids(acc);
+        iterations_ = iter + 1;
+
+        if (verbose_) std::cout << "Iteration " << iter + 1 << ": Centroids updated." << std::endl;
+
+        if (!moved) {
+            if (verbose_) std::cout << "K-Means converged after " << iter + 1 << " iterations." << std::endl;
+            break;
+        }
+        
+        if (iter == MAX_ITERATIONS - 1 && verbose_) {
+            std::cout << "K-Means reached max iterations (" << MAX_ITERATIONS << ")." << std::endl;
+        }
+    }
+
+    inertia_ = compute_inertia(rows, cluster_ids.data());
+    return inertia_;
+}
+
+/**
+ * @brief Labels every row with its nearest final centroid (when cluster_ids is
+ * non-null) and returns the summed squared distances; also packs the centroids
+ * for predict_batch().
+ */
+double KMeansClusterer::compute_inertia(const Dataset& rows, int* cluster_ids) {
+
+    search_.assign(centroids);
+
+    const size_t chunks = parallel_chunks(rows.rows(), min_rows_per_chunk(rows.cols()));
+    std::vector<double> partial(chunks, 0.0);
+
+    parallel_for(rows.rows(), min_rows_per_chunk(rows.cols()), [&](size_t chunk, size_t begin, size_t end) {
+
+        int labels[kAssignTile];
+        double distances[kAssignTile];
+        double inertia = 0.0;
+        for (size_t r0 = begin; r0 < end; r0 += kAssignTile) {
+
+            const size_t m = std::min(kAssignTile, end - r0);
+            search_.nearest(rows.row_ptr(r0), m, rows.leading_dim(), labels, distances);
+
+            for (size_t i = 0; i < m; ++i) {
+                if (cluster_ids) cluster_ids[r0 + i] = labels[i];
+                inertia += distances[i];
+            }
+        }
+        partial[chunk] = inertia;
+    });
+
+    double total = 0.0;
+    for (double p : partial) total += p;
+    return total;
+}
+
+/**
+ * @brief Streaming training loop: assignment and centroid accumulation share one
+ * parallel pass per batch, summed across the stream's batches.
+ */
+void KMeansClusterer::train(DatasetStream& stream) {
+
+    if (batch_size_ > 0) {
+        train_mini_batch(stream);
+        return;
+    }
+
+    initialize_centroids(stream);
+    if (centroids.size() < static_cast<size_t>(K)) {
+        std::cerr << "Error: Dataset size is insufficient for K-Means with K=" << K << std::endl;
+        return;
+    }
+    std::cout << "--- Streamed K-Means Training Started (K=" << K << ") ---" << std::endl;
+
+    const size_t dim = stream.cols();
+    distance_evaluations_ = 0;
+    Accumulators acc;
+    acc.resize(parallel_chunks(stream.batch_rows(), min_rows_per_chunk(dim)), K, dim);
+    Dataset batch;
+
+    for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+
+        acc.reset();
+        stream.rewind();
+        while (stream.next_batch(batch)) assign_clusters(batch, nullptr, &acc);
+
+        bool moved = update_centroids(acc);
+        iterations_ = iter + 1;
 
         std::cout << "Iteration " << iter + 1 << ": Centroids updated." << std::endl;
 
@@ -156,10 +911,198 @@ void KMeansClusterer::train(std::vector<DataPoint>& data) {
             std::cout << "K-Means converged after " << iter + 1 << " iterations." << std::endl;
             break;
         }
-        
         if (iter == MAX_ITERATIONS - 1) {
             std::cout << "K-Means reached max iterations (" << MAX_ITERATIONS << ")." << std::endl;
         }
     }
+
+    search_.assign(centroids);
+}
+
+/**
+ * @brief One mini-batch step. Each centroid becomes the running mean of every row it
+ * has absorbed: c += (S − m·c) / absorbed, where S sums the batch's m rows nearest to c.
+ */
+double KMeansClusterer::mini_batch_step(const Dataset& rows, const size_t* order, size_t first, size_t count,
+                                        std::vector<double>& sums, std::vector<size_t>& batch_counts,
+                                        std::vector<double>& absorbed) {
+
+    const size_t dim = rows.cols();
+    std::fill(sums.begin(), sums.end(), 0.0);
+    std::fill(batch_counts.begin(), batch_counts.end(), 0);
+
+    double inertia = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+
+        const real* x = rows.row_ptr(order ? order[i] : first + i);
+        double min_dist = std::numeric_limits<double>::max();
+        int best = -1;
+
+        for (int c = 0; c < K; ++c) {
+            double d = squared_distance(x, centroids[c].data(), dim);
+            if (d < min_dist) { min_dist = d; best = c; }
+        }
+        if (best < 0) throw_non_finite_row();
+
+        inertia += min_dist;
+        batch_counts[best]++;
+        simd::multiply_accumulate(1.0, x, sums.data() + best * dim, dim);
+    }
+    distance_evaluations_ += count * K;
+
+    for (int c = 0; c < K; ++c) {
+
+        if (batch_counts[c] == 0) continue;
+
+        absorbed[c] += batch_counts[c];
+        const double rate = 1.0 / absorbed[c];
+        const double* s = sums.data() + c * dim;
+        for (size_t j = 0; j < dim; ++j) {
+            centroids[c][j] += static_cast<real>((s[j] - batch_counts[c] * centroids[c][j]) * rate);
+        }
+    }
+    return inertia;
+}
+
+/**
+ * @brief Mini-batch training on an in-memory dataset: uniform random batches, then
+ * one final assignment pass to fill data.cluster_ids().
+ */
+void KMeansClusterer::train_mini_batch(Dataset& data) {
+
+    const Dataset rows = data.as_row_major();
+    const size_t n = rows.rows(), dim = rows.cols();
+
+    std::mt19937_64 rng = make_rng();
+    std::uniform_int_distribution<size_t> any_row(0, n - 1);
+
+    // Seed from a uniform sample so that seeding cost does not grow with N
+    const size_t sample_rows = std::min(n, std::max(3 * batch_size_, 3 * static_cast<size_t>(K)));
+    Dataset sample(sample_rows, dim);
+    for (size_t i = 0; i < sample_rows; ++i) {
+        const real* row = rows.row_ptr(any_row(rng));
+        std::copy(row, row + dim, sample.row_ptr(i));
+    }
+    initialize_centroids(sample);
+
+    std::cout << "--- Mini-batch K-Means Training Started (K=" << K << ", init=" << init_name(init_)
+              << ", batch size " << batch_size_ << ") ---" << std::endl;
+
+    distance_evaluations_ = 0;
+    std::vector<double> sums(K * dim), absorbed(K, 0.0);
+    std::vector<size_t> batch_counts(K), order(batch_size_);
+    const size_t steps_per_pass = (n + batch_size_ - 1) / batch_size_;
+
+    InertiaMonitor monitor;
+    size_t steps = 0;
+    bool converged = false;
+
+    for (int pass = 0; pass < MAX_ITERATIONS && !converged; ++pass) {
+
+        for (size_t s = 0; s < steps_per_pass && !converged; ++s, ++steps) {
+            for (size_t& r : order) r = any_row(rng);
+            double inertia = mini_batch_step(rows, order.data(), 0, order.size(), sums, batch_counts, absorbed);
+            converged = monitor.update(inertia / order.size(), tolerance_);
+        }
+        std::cout << "Pass " << pass + 1 << ": smoothed batch inertia " << monitor.smoothed << std::endl;
+    }
+
+    if (converged) std::cout << "Mini-batch K-Means converged after " << steps << " steps." << std::endl;
+    else std::cout << "Mini-batch K-Means reached max passes (" << MAX_ITERATIONS << ")." << std::endl;
+
+    iterations_ = static_cast<int>(steps);
+    inertia_ = compute_inertia(rows, data.cluster_ids().data());
 }
-} // namespace aicpp
\ No newline at end of file
+
+/**
+ * @brief Mini-batch training over a stream: the stream's batches are split into
+ * batch_size steps in order, and each pass is one rewind of the stream.
+ */
+void KMeansClusterer::train_mini_batch(DatasetStream& stream) {
+
+    const size_t dim = stream.cols();
+    const size_t sample_rows = std::max(3 * batch_size_, 3 * static_cast<size_t>(K));
+
+    // Seed from the first rows of the stream
+    Dataset sample(sample_rows, dim);
+    Dataset batch;
+    size_t filled = 0;
+
+    stream.rewind();
+    while (filled < sample_rows && stream.next_batch(batch)) {
+        for (size_t r = 0; r < batch.rows() && filled < sample_rows; ++r, ++filled) {
+            std::copy(batch.row_ptr(r), batch.row_ptr(r) + dim, sample.row_ptr(filled));
+        }
+    }
+    if (filled < static_cast<size_t>(K)) {
+        std::cerr << "Error: Dataset size is insufficient for K-Means with K=" << K << std::endl;
+        return;
+    }
+    initialize_centroids(Dataset::view(sample.data(), filled, dim, Layout::RowMajor));
+
+    std::cout << "--- Streamed Mini-batch K-Means Training Started (K=" << K << ", init=" << init_name(init_)
+              << ", batch size " << batch_size_ << ") ---" << std::endl;
+
+    distance_evaluations_ = 0;
+    std::vector<double> sums(K * dim), absorbed(K, 0.0);
+    std::vector<size_t> batch_counts(K);
+
+    InertiaMonitor monitor;
+    size_t steps = 0;
+    bool converged = false;
+
+    for (int pass = 0; pass < MAX_ITERATIONS && !converged; ++pass) {
+
+        inertia_ = 0.0;
+        stream.rewind();
+        while (!converged && stream.next_batch(batch)) {
+            for (size_t first = 0; first < batch.rows() && !converged; first += batch_size_, ++steps) {
+                const size_t count = std::min(batch_size_, batch.rows() - first);
+                double inertia = mini_batch_step(batch, nullptr, first, count, sums, batch_counts, absorbed);
+                inertia_ += inertia;
+                converged = monitor.update(inertia / count, tolerance_);
+            }
+        }
+        std::cout << "Pass " << pass + 1 << ": smoothed batch inertia " << monitor.smoothed << std::endl;
+    }
+
+    if (converged) std::cout << "Mini-batch K-Means converged after " << steps << " steps." << std::endl;
+    else std::cout << "Mini-batch K-Means reached max passes (" << MAX_ITERATIONS << ")." << std::endl;
+
+    iterations_ = static_cast<int>(steps);
+    search_.assign(centroids);
+}
+
+// --- Prediction ---
+int KMeansClusterer::predict(const std::vector<real>& features) const {
+
+    if (centroids.empty()) throw std::runtime_error("KMeansClusterer has not been trained.");
+    if (features.size() != centroids[0].size()) throw std::runtime_error("Feature size mismatch.");
+
+    int label = 0;
+    search_.nearest(features.data(), 1, features.size(), &label, nullptr);
+    return label;
+}
+
+void KMeansClusterer::predict_batch(const Dataset& X, int* out) const {
+
+    if (centroids.empty()) throw std::runtime_error("KMeansClusterer has not been trained.");
+    if (X.cols() != centroids[0].size()) throw std::runtime_error("Feature size mismatch.");
+
+    const Dataset rows = X.as_row_major();
+    parallel_for(rows.rows(), min_rows_per_chunk(rows.cols()), [&](size_t, size_t begin, size_t end) {
+        search_.nearest(rows.row_ptr(begin), end - begin, rows.leading_dim(), out + begin, nullptr);
+    });
+}
+
+void KMeansClusterer::predict_batch(const real* X, size_t rows, int* out) const {
+
+    if (centroids.empty()) throw std::runtime_error("KMeansClusterer has not been trained.");
+
+    const size_t dim = centroids[0].size();
+    parallel_for(rows, min_rows_per_chunk(dim), [&](size_t, size_t begin, size_t end) {
+        search_.nearest(X + begin * dim, end - begin, dim, out + begin, nullptr);
+    });
+}
+
+} // namespace aicpp
@@ -2,10 +2,16 @@
 #define AI_LAB_K_MEANS_CLUSTERER_H
 
 #include "core/data_types.h"
+#include "core/dataset.h"
+#include "core/distance.h"
+#include <cstdint>
+#include <random>
 #include <vector>
 #include <cmath>
 #include <numeric>
 
+class DatasetStream;
+
 namespace aicpp {
 
 /**
@@ -15,33 +21,198 @@ class KMeansClusterer {
 
 public:
 
-    KMeansClusterer(int k, int max_iters);
+    /**
+     * @brief Centroid seeding for in-memory training.
+     * * Random: K distinct rows chosen uniformly.
+     * * KMeansPlusPlus: each new centroid is a row drawn with probability proportional
+     *   to its squared distance to the nearest centroid so far (K passes over the data).
+     * * KMeansParallel: k-means||, a few parallel rounds that oversample about 2K rows
+     *   each, reclustered to K with weighted k-means++; for large N and K.
+     * Streamed training always seeds from a reservoir sample.
+     */
+    enum class Init { Random, KMeansPlusPlus, KMeansParallel };
+
+    /**
+     * @brief Assignment step for in-memory training; all three give the same clusters.
+     * * Lloyd: every point against every centroid, O(N·K·D) per iteration.
+     * * Hamerly: one upper and one lower bound per point plus half the distance to
+     *   each centroid's nearest neighbour; O(N) extra memory, best for small K.
+     * * Elkan: K lower bounds per point and all centroid-centroid distances; skips
+     *   the most distance computations at large K, at O(N·K) extra memory.
+     * Bounds are kept with a rounding margin and every distance that is computed
+     * is compared exactly as Lloyd does, so the assignments are bit-identical.
+     */
+    enum class Algorithm { Lloyd, Hamerly, Elkan };
+
+    KMeansClusterer(int k, int max_iters, Init init = Init::KMeansPlusPlus,
+                    Algorithm algorithm = Algorithm::Lloyd);
+
+    /**
+     * @brief Fixes the seed of all random choices so that training is reproducible,
+     * independent of the thread count. Without it every run is seeded from std::random_device.
+     */
+    void set_seed(uint64_t seed);
+
+    /**
+     * @brief Switches both train() overloads to mini-batch k-means (Sculley, 2010).
+     * Every step assigns batch_size rows and moves each centroid toward the mean of
+     * its rows with a per-centroid learning rate 1 / (rows it has absorbed so far).
+     * In-memory training samples batches at random. Streamed training consumes the
+     * stream's batches in order, so the stream should be shuffled. Centroids are
+     * seeded from a sample of max(3·batch_size, 3·K) rows. max_iters counts passes
+     * over the data. Training also stops once the smoothed mean batch inertia has not
+     * improved by a relative `tolerance` for 10 consecutive steps. Memory is
+     * O(K·D + batch_size), independent of N. batch_size = 0 restores full Lloyd.
+     */
+    void set_mini_batch(size_t batch_size, double tolerance = 1e-4);
+
+    /**
+     * @brief Runs full-batch in-memory training n_init times from independent seeds
+     * and keeps the centroids with the lowest inertia. The restarts run concurrently
+     * on the thread pool and share the read-only dataset; each keeps only its own
+     * centroids and labels. With set_seed(s), restart i is seeded with s + i, so the
+     * result does not depend on the thread count. Mini-batch and streamed training
+     * ignore it.
+     */
+    void set_n_init(int n_init);
 
     /**
      * @brief Trains the K-Means model on the provided data.
      */
     void train(std::vector<DataPoint>& data);
 
+    /**
+     * @brief Trains on a Dataset; assignments are written to data.cluster_ids().
+     */
+    void train(Dataset& data);
+
+    /**
+     * @brief Out-of-core Lloyd iterations: every iteration is one pass over the
+     * stream, and only the K centroids plus per-cluster sums are kept in memory.
+     * Initial centroids are a uniform reservoir sample of K rows.
+     */
+    void train(DatasetStream& stream);
+
     /**
      * @brief Returns the final calculated centroid coordinates.
      */
-    const std::vector<std::vector<double>>& get_centroids() const {
+    const std::vector<std::vector<real>>& get_centroids() const {
         return centroids;
     }
 
+    /**
+     * @brief Point-to-centroid distances computed by the assignment steps of the last train().
+     */
+    size_t distance_evaluations() const { return distance_evaluations_; }
+
+    /**
+     * @brief Sum of squared distances from each row to its centroid after the last
+     * train(). Streamed training reports the sum measured during its final pass.
+     */
+    double inertia() const { return inertia_; }
+
+    /**
+     * @brief Lloyd iterations (mini-batch steps) run by the last train(); with
+     * n_init restarts, those of the kept run.
+     */
+    int iterations() const { return iterations_; }
+
+    /**
+     * @brief Index of the nearest centroid; throws if the model is untrained or
+     * the feature count does not match. Rows with NaN get -1.
+     */
+    int predict(const std::vector<real>& features) const;
+
+    /**
+     * @brief Nearest centroid for every row of X into out[0..X.rows()) (-1 for rows
+     * with NaN), using the blocked distance engine split across the thread pool.
+     */
+    void predict_batch(const Dataset& X, int* out) const;
+
+    // Same, for `rows` contiguous row-major rows of get_centroids()[0].size() features
+    void predict_batch(const real* X, size_t rows, int* out) const;
+
 private:
 
     int K;
     int MAX_ITERATIONS;
+    Init init_;
+    Algorithm algorithm_;
+    bool has_seed_ = false;
+    uint64_t seed_ = 0;
+    size_t batch_size_ = 0;
+    double tolerance_ = 1e-4;
+    int n_init_ = 1;
+    bool verbose_ = true;
+    int iterations_ = 0;
+    double inertia_ = 0.0;
+
+    std::vector<std::vector<real>> centroids;
+
+    // Packed copy of the centroids for the blocked Lloyd assignment
+    CentroidSet search_;
+
+    // Distance each centroid moved in the last update step
+    std::vector<double> drift_;
+    size_t distance_evaluations_ = 0;
+
+    // Hamerly / Elkan state: upper bound per point; lower bounds per point (Hamerly)
+    // or per point and centroid (Elkan)
+    struct Bounds {
+        std::vector<double> upper;
+        std::vector<double> lower;
+    };
+
+    // Per-chunk centroid sums (K x dim, flat), counts, distance counts and inertia for the
+    // parallel passes; sized once per train() and zeroed before every pass
+    struct Accumulators {
+        size_t dim = 0;
+        std::vector<std::vector<double>> sums;
+        std::vector<std::vector<size_t>> counts;
+        std::vector<size_t> evaluations;
+        std::vector<double> inertia;
+
+        void resize(size_t chunks, size_t k, size_t d);
+        void reset();
+        void add(size_t chunk, int id, const real* x);
+    };
+
+    size_t min_rows_per_chunk(size_t dim) const;
+
+    real squared_distance(const real* p1, const real* p2, size_t dim) const;
+
+    std::mt19937_64 make_rng() const;
+
+    // Dataset arguments are row-major
+    void initialize_centroids(const Dataset& data);
+    void seed_random(const Dataset& data, std::mt19937_64& rng);
+    void seed_plus_plus(const Dataset& data, std::mt19937_64& rng);
+    void seed_parallel(const Dataset& data, std::mt19937_64& rng);
+    void initialize_centroids(DatasetStream& stream);
+    void assign_clusters(const Dataset& data, int* cluster_ids, Accumulators* acc);
+
+    // One full-batch run on row-major rows; returns its final inertia
+    double fit(const Dataset& rows, std::vector<int>& cluster_ids);
 
-    std::vector<std::vector<double>> centroids;
+    // Labels rows with their nearest centroid (if cluster_ids is non-null) and
+    // returns the exact inertia; also packs the centroids for prediction
+    double compute_inertia(const Dataset& rows, int* cluster_ids);
 
-    double euclidean_distance(const std::vector<double>& p1,
-                              const std::vector<double>& p2) const;
+    // Mini-batch training (see set_mini_batch)
+    void train_mini_batch(Dataset& data);
+    void train_mini_batch(DatasetStream& stream);
 
-    void initialize_centroids(const std::vector<DataPoint>& data);
-    void assign_clusters(std::vector<DataPoint>& data);
-    bool update_centroids(const std::vector<DataPoint>& data);
+    // Rows order[0..count) (rows [first, first + count) when order is null) pull their
+    // nearest centroids toward them; `absorbed` counts rows per centroid so far.
+    // Returns the batch's summed squared distance before the update.
+    double mini_batch_step(const Dataset& rows, const size_t* order, size_t first, size_t count,
+                           std::vector<double>& sums, std::vector<size_t>& batch_counts,
+                           std::vector<double>& absorbed);
+    void assign_hamerly(const Dataset& data, std::vector<int>& cluster_ids, Bounds& bounds, bool first,
+                        Accumulators& acc);
+    void assign_elkan(const Dataset& data, std::vector<int>& cluster_ids, Bounds& bounds, bool first,
+                      Accumulators& acc);
+    bool update_centroids(Accumulators& acc);
 };
 
 } // namespace aicpp
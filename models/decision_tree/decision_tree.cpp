@@ -1,104 +1,463 @@
 #include "models/decision_tree/decision_tree.h"
+#include "core/binning.h"
+#include "core/thread_pool.h"
 #include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <limits>
+#include <random>
+#include <stdexcept>
 
 namespace aicpp {
 
-DecisionTreeClassifier::DecisionTreeClassifier(int max_depth, int min_samples_split)
-    : MAX_DEPTH(max_depth), MIN_SAMPLES_SPLIT(min_samples_split) {}
+namespace {
 
-void DecisionTreeClassifier::train(std::vector<DataPoint>& data) {
-    root = build_tree(data, 0);
+// Rows x features per chunk of a split search or histogram fill; smaller nodes use one thread
+const size_t kMinSplitWork = size_t(1) << 16;
+
+// Weighted Gini impurity of a split from its class counts: the size-weighted mean of
+// 1 - (p0² + p1²) over both sides, with the arithmetic of the original per-candidate
+// recount so that the exact splitter picks bit-identical costs
+double split_cost(size_t left0, size_t left1, size_t right0, size_t right1) {
+
+    auto gini = [](size_t count0, size_t count1) {
+        size_t n = count0 + count1;
+        if (n == 0) return 0.0;
+        double p0 = (double)count0 / n;
+        double p1 = (double)count1 / n;
+        return 1.0 - (p0 * p0 + p1 * p1);
+    };
+
+    size_t left = left0 + left1, right = right0 + right1;
+    double total = left + right;
+    return (left / total) * gini(left0, left1) + (right / total) * gini(right0, right1);
 }
 
-int DecisionTreeClassifier::predict(const DataPoint& point) const {
-    const TreeNode* node = root.get();
-    while (!node->is_leaf) {
-        if (point.features[node->feature_index] < node->threshold)
-            node = node->left.get();
-        else
-            node = node->right.get();
+// Fewest rows per prediction chunk
+const size_t kMinPredictRows = 4096;
+
+// Class of every row [begin, end) into out; row(r) returns a pointer to the features of row r
+template <class RowFn>
+void walk_rows(const FlatNode* nodes, const int* classes, int depth, size_t begin, size_t end,
+               RowFn row, int* out) {
+
+    const real* x[kFlatLanes];
+    uint32_t at[kFlatLanes];
+
+    for (size_t r0 = begin; r0 < end; r0 += kFlatLanes) {
+        const size_t m = std::min(kFlatLanes, end - r0);
+        for (size_t l = 0; l < m; ++l) x[l] = row(r0 + l);
+        descend(nodes, depth, x, m, at);
+        for (size_t l = 0; l < m; ++l) out[r0 + l] = classes[at[l]];
     }
-    return node->class_label;
 }
 
-std::unique_ptr<TreeNode> DecisionTreeClassifier::build_tree(std::vector<DataPoint>& data, int depth) {
+/**
+ * @brief Features a node may split on: all of them, or max_features drawn without
+ * replacement (a partial Fisher-Yates shuffle) and returned in ascending order, so
+ * ties still go to the lowest feature index.
+ */
+class FeatureSampler {
+public:
+
+    FeatureSampler(size_t cols, int max_features, uint64_t seed)
+        : pool_(cols), rng_(seed) {
+        for (size_t f = 0; f < cols; ++f) pool_[f] = static_cast<uint32_t>(f);
+        count_ = (max_features <= 0) ? cols : std::min(cols, static_cast<size_t>(max_features));
+        if (count_ == cols) selected_ = pool_;
+    }
+
+    const std::vector<uint32_t>& draw() {
+        if (count_ == pool_.size()) return selected_;
+        for (size_t i = 0; i < count_; ++i) {
+            std::uniform_int_distribution<size_t> pick(i, pool_.size() - 1);
+            std::swap(pool_[i], pool_[pick(rng_)]);
+        }
+        selected_.assign(pool_.begin(), pool_.begin() + count_);
+        std::sort(selected_.begin(), selected_.end());
+        return selected_;
+    }
+
+private:
+
+    std::vector<uint32_t> pool_;
+    std::vector<uint32_t> selected_;
+    size_t count_;
+    std::mt19937_64 rng_;
+};
+
+// Whether a node of n rows at this depth looks for a split at all
+bool looks_for_split(int depth, size_t n, int max_depth, int min_split) {
+    return depth < max_depth && n >= static_cast<size_t>(min_split) && n > 0;
+}
+
+// Leaf predicting the majority class of rows index[begin, end); ties go to class 0
+std::unique_ptr<TreeNode> make_leaf(const std::vector<uint32_t>& index, size_t begin, size_t end,
+                                    const std::vector<uint8_t>& classes) {
+    size_t count1 = 0;
+    for (size_t i = begin; i < end; ++i) count1 += classes[index[i]];
     auto node = std::make_unique<TreeNode>();
+    node->is_leaf = true;
+    node->class_label = (count1 > (end - begin) - count1) ? 1 : 0;
+    return node;
+}
+
+/**
+ * @brief Grows the exact tree, the one the original per-candidate search built.
+ * * Rows are one permutation array. Each node owns a contiguous range of it, kept
+ * in row order by a stable partition. Per node, every feature is sorted once as
+ * (value, row) pairs and swept with running class counts. Each distinct value v is
+ * a threshold x < v whose cost comes from the prefix counts. Equal costs resolve as
+ * the original loop did: earlier feature first, then the value whose first row
+ * comes first. Extra memory is O(N) plus one sort buffer per thread.
+ * * `rows` may repeat rows (a bootstrap sample); a repeated row simply counts twice.
+ */
+class ExactGrower {
+public:
+
+    ExactGrower(const Dataset& data, const std::vector<uint8_t>& classes, std::vector<uint32_t> rows,
+                int max_depth, int min_split, FeatureSampler& features)
+        : data_(data), classes_(classes), max_depth_(max_depth), min_split_(min_split),
+          features_(features), index_(std::move(rows)) {}
+
+    std::unique_ptr<TreeNode> grow() { return grow(0, index_.size(), 0); }
+
+private:
+
+    struct Candidate {
+        double cost = std::numeric_limits<double>::max();
+        uint32_t row = std::numeric_limits<uint32_t>::max();  // first row holding the threshold
+        real threshold = 0;
+    };
+
+    const Dataset& data_;
+    const std::vector<uint8_t>& classes_;
+    int max_depth_;
+    int min_split_;
+    FeatureSampler& features_;
+    std::vector<uint32_t> index_;
+
+    std::unique_ptr<TreeNode> grow(size_t begin, size_t end, int depth) {
+
+        const size_t n = end - begin;
+        if (!looks_for_split(depth, n, max_depth_, min_split_)) return make_leaf(index_, begin, end, classes_);
+
+        size_t total1 = 0;
+        for (size_t i = begin; i < end; ++i) total1 += classes_[index_[i]];
+        const size_t total0 = n - total1;
 
-    // --- Умова зупинки ---
-    if (depth >= MAX_DEPTH || data.size() < MIN_SAMPLES_SPLIT) {
-        int count0 = 0, count1 = 0;
-        for (auto& d : data) (d.label == 0) ? count0++ : count1++;
-        node->is_leaf = true;
-        node->class_label = (count1 > count0) ? 1 : 0;
+        // Best threshold of every candidate feature, features split across the pool
+        const std::vector<uint32_t>& features = features_.draw();
+        std::vector<Candidate> best(features.size());
+        const size_t min_features = std::max<size_t>(1, kMinSplitWork / n);
+
+        parallel_for(features.size(), min_features, [&](size_t, size_t k0, size_t k1) {
+
+            thread_local std::vector<std::pair<real, uint32_t>> sorted;
+            sorted.resize(n);
+
+            for (size_t k = k0; k < k1; ++k) {
+
+                const uint32_t f = features[k];
+                for (size_t i = 0; i < n; ++i) {
+                    uint32_t r = index_[begin + i];
+                    sorted[i] = { data_(r, f), r };
+                }
+                std::sort(sorted.begin(), sorted.end());
+
+                Candidate& c = best[k];
+                size_t left0 = 0, left1 = 0;
+                for (size_t j = 0; j < n; ) {
+                    const real v = sorted[j].first;
+                    if (j > 0) {
+                        double cost = split_cost(left0, left1, total0 - left0, total1 - left1);
+                        if (cost < c.cost || (cost == c.cost && sorted[j].second < c.row)) {
+                            c = { cost, sorted[j].second, v };
+                        }
+                    }
+                    for (; j < n && sorted[j].first == v; ++j) {
+                        if (classes_[sorted[j].second]) ++left1;
+                        else ++left0;
+                    }
+                }
+            }
+        });
+
+        int best_feature = -1;
+        real threshold = 0;
+        double best_cost = std::numeric_limits<double>::max();
+        for (size_t k = 0; k < best.size(); ++k) {
+            if (best[k].cost < best_cost) {
+                best_cost = best[k].cost;
+                best_feature = static_cast<int>(features[k]);
+                threshold = best[k].threshold;
+            }
+        }
+
+        if (best_feature == -1) return make_leaf(index_, begin, end, classes_);
+
+        const size_t mid = std::stable_partition(index_.begin() + begin, index_.begin() + end,
+                                                 [&](uint32_t r) { return data_(r, best_feature) < threshold; })
+                           - index_.begin();
+
+        auto node = std::make_unique<TreeNode>();
+        node->feature_index = best_feature;
+        node->threshold = threshold;
+        node->left = grow(begin, mid, depth + 1);
+        node->right = grow(mid, end, depth + 1);
         return node;
     }
+};
+
+/**
+ * @brief Grows a tree on binned features. Rows are one permutation array that is
+ * partitioned in place, so every node owns a contiguous range of it. A histogram
+ * holds class-0/class-1 counts for every (feature, bin); there is one scratch
+ * histogram per depth, since a node's own histogram is turned into its larger
+ * child's by subtracting the smaller child's. Histograms always cover every
+ * feature so that the subtraction stays valid; feature sampling only limits the
+ * search.
+ */
+class HistogramGrower {
+public:
+
+    HistogramGrower(const BinnedMatrix& bins, const std::vector<uint8_t>& classes, std::vector<uint32_t> rows,
+                    int max_depth, int min_split, FeatureSampler& features)
+        : bins_(bins), classes_(classes), max_depth_(max_depth), min_split_(min_split),
+          features_(features), index_(std::move(rows)) {
+
+        offsets_.resize(bins.cols() + 1, 0);
+        for (size_t f = 0; f < bins.cols(); ++f) offsets_[f + 1] = offsets_[f] + 2 * bins.bins(f);
+    }
+
+    std::unique_ptr<TreeNode> grow() {
+        const size_t n = index_.size();
+        if (splits(0, n)) fill(0, n, slot(0));
+        return grow(0, n, 0, slot(0));
+    }
+
+private:
+
+    using Histogram = std::vector<uint32_t>;
+
+    const BinnedMatrix& bins_;
+    const std::vector<uint8_t>& classes_;
+    int max_depth_;
+    int min_split_;
+    FeatureSampler& features_;
+    std::vector<size_t> offsets_;    // start of each feature's bins in a histogram
+    std::vector<uint32_t> index_;    // row permutation
+    std::deque<Histogram> slots_;    // scratch histogram per depth; references stay valid as it grows
+
+    Histogram& slot(int depth) {
+        while (slots_.size() <= static_cast<size_t>(depth)) slots_.emplace_back();
+        slots_[depth].resize(offsets_.back());
+        return slots_[depth];
+    }
 
-    double best_gini = std::numeric_limits<double>::max();
-    int best_feature = -1;
-    double best_threshold = 0.0;
-    std::vector<DataPoint> best_left, best_right;
+    bool splits(int depth, size_t n) const { return looks_for_split(depth, n, max_depth_, min_split_); }
 
-    int num_features = data[0].features.size();
+    // Counts of rows [begin, end) of the permutation, features split across the pool
+    void fill(size_t begin, size_t end, Histogram& h) const {
 
-    for (int feature = 0; feature < num_features; ++feature) {
-        for (auto& d : data) {
-            double threshold = d.features[feature];
+        const size_t n = end - begin;
+        const size_t min_features = std::max<size_t>(1, kMinSplitWork / std::max<size_t>(n, 1));
 
-            std::vector<DataPoint> left, right;
-            for (auto& sample : data) {
-                if (sample.features[feature] < threshold)
-                    left.push_back(sample);
-                else
-                    right.push_back(sample);
+        parallel_for(bins_.cols(), min_features, [&](size_t, size_t f0, size_t f1) {
+            for (size_t f = f0; f < f1; ++f) {
+                uint32_t* counts = h.data() + offsets_[f];
+                std::fill(counts, h.data() + offsets_[f + 1], 0);
+                const uint8_t* codes = bins_.column(f);
+                for (size_t i = begin; i < end; ++i) {
+                    uint32_t r = index_[i];
+                    ++counts[2 * codes[r] + classes_[r]];
+                }
             }
+        });
+    }
+
+    std::unique_ptr<TreeNode> grow(size_t begin, size_t end, int depth, Histogram& h) {
+
+        const size_t n = end - begin;
+        if (!splits(depth, n)) return make_leaf(index_, begin, end, classes_);
+
+        // Class totals of the node, from any one feature's bins
+        size_t total0 = 0, total1 = 0;
+        for (size_t e = offsets_[0]; e < offsets_[1]; e += 2) {
+            total0 += h[e];
+            total1 += h[e + 1];
+        }
 
-            if (left.empty() || right.empty()) continue;
+        // Sweep the bins of every feature with running class counts. A cut is a
+        // candidate only before an occupied bin, so the threshold equals the smallest
+        // right-hand value whenever that value has its own bin, as in build_tree.
+        double best_cost = std::numeric_limits<double>::max();
+        int best_feature = -1, best_bin = -1;
 
-            double cost = compute_split_cost(left, right);
-            if (cost < best_gini) {
-                best_gini = cost;
-                best_feature = feature;
-                best_threshold = threshold;
-                best_left = left;
-                best_right = right;
+        for (uint32_t f : features_.draw()) {
+            const uint32_t* counts = h.data() + offsets_[f];
+            size_t left0 = 0, left1 = 0;
+            for (int b = 0; b + 1 < bins_.bins(f); ++b) {
+                left0 += counts[2 * b];
+                left1 += counts[2 * b + 1];
+                if (left0 + left1 == 0) continue;
+                if (left0 + left1 == n) break;
+                if (counts[2 * b + 2] + counts[2 * b + 3] == 0) continue;
+
+                double cost = split_cost(left0, left1, total0 - left0, total1 - left1);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_feature = static_cast<int>(f);
+                    best_bin = b;
+                }
             }
         }
-    }
 
-    if (best_feature == -1) {
-        int count0 = 0, count1 = 0;
-        for (auto& d : data) (d.label == 0) ? count0++ : count1++;
-        node->is_leaf = true;
-        node->class_label = (count1 > count0) ? 1 : 0;
+        if (best_feature == -1) return make_leaf(index_, begin, end, classes_);
+
+        const uint8_t* codes = bins_.column(best_feature);
+        const size_t mid = std::partition(index_.begin() + begin, index_.begin() + end,
+                                          [&](uint32_t r) { return codes[r] <= best_bin; }) - index_.begin();
+
+        // Build the smaller child's histogram and turn this node's into the larger child's
+        const bool left_smaller = mid - begin <= end - mid;
+        const size_t small_begin = left_smaller ? begin : mid;
+        const size_t small_end = left_smaller ? mid : end;
+        Histogram& small = slot(depth + 1);
+
+        if (splits(depth + 1, mid - begin) || splits(depth + 1, end - mid)) {
+            fill(small_begin, small_end, small);
+            for (size_t e = 0; e < h.size(); ++e) h[e] -= small[e];
+        }
+
+        auto node = std::make_unique<TreeNode>();
+        node->feature_index = best_feature;
+        node->threshold = bins_.threshold(best_feature, best_bin);
+
+        // The smaller child first: its subtree only touches deeper slots, leaving h intact
+        auto small_child = grow(small_begin, small_end, depth + 1, small);
+        auto large_child = left_smaller ? grow(mid, end, depth + 1, h) : grow(begin, mid, depth + 1, h);
+        node->left = left_smaller ? std::move(small_child) : std::move(large_child);
+        node->right = left_smaller ? std::move(large_child) : std::move(small_child);
         return node;
     }
+};
 
-    node->feature_index = best_feature;
-    node->threshold = best_threshold;
-    node->left = build_tree(best_left, depth + 1);
-    node->right = build_tree(best_right, depth + 1);
-    return node;
+} // namespace
+
+DecisionTreeClassifier::DecisionTreeClassifier(int max_depth, int min_samples_split,
+                                               Splitter splitter, int max_bins)
+    : MAX_DEPTH(max_depth), MIN_SAMPLES_SPLIT(min_samples_split),
+      splitter_(splitter), max_bins_(max_bins) {}
+
+void DecisionTreeClassifier::set_max_features(int max_features) {
+    max_features_ = max_features;
 }
 
-double DecisionTreeClassifier::gini_impurity(const std::vector<DataPoint>& data) {
-    if (data.empty()) return 0.0;
-    int count0 = 0, count1 = 0;
-    for (auto& d : data) (d.label == 0) ? count0++ : count1++;
-    double p0 = (double)count0 / data.size();
-    double p1 = (double)count1 / data.size();
-    return 1.0 - (p0 * p0 + p1 * p1);
+void DecisionTreeClassifier::set_seed(uint64_t seed) {
+    has_seed_ = true;
+    seed_ = seed;
 }
 
-double DecisionTreeClassifier::compute_split_cost(
-    const std::vector<DataPoint>& left,
-    const std::vector<DataPoint>& right) 
-{
-    double total = left.size() + right.size();
-    double gini_left = gini_impurity(left);
-    double gini_right = gini_impurity(right);
-    return (left.size() / total) * gini_left + (right.size() / total) * gini_right;
+void DecisionTreeClassifier::train(std::vector<DataPoint>& data) {
+
+    // As before, a point is class 0 when its label is 0 and class 1 otherwise
+    std::vector<uint8_t> classes(data.size());
+    for (size_t r = 0; r < data.size(); ++r) classes[r] = data[r].label == 0 ? 0 : 1;
+
+    Dataset points = Dataset::from_points(data);
+    train(points, classes);
+}
+
+void DecisionTreeClassifier::train(const Dataset& data) {
+    if (!data.has_labels()) throw std::runtime_error("Dataset must have a label array.");
+    train(data, binary_classes(data));
+}
+
+void DecisionTreeClassifier::train(const Dataset& data, const std::vector<uint8_t>& classes) {
+
+    if (data.rows() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("DecisionTreeClassifier supports at most 2^32 - 1 rows.");
+    }
+
+    std::vector<uint32_t> rows(data.rows());
+    for (size_t r = 0; r < rows.size(); ++r) rows[r] = static_cast<uint32_t>(r);
+
+    if (splitter_ == Splitter::Histogram) {
+        BinnedMatrix bins;
+        bins.build(data, max_bins_);
+        grow(data, &bins, classes, std::move(rows));
+    } else {
+        grow(data, nullptr, classes, std::move(rows));
+    }
+}
+
+std::vector<uint8_t> DecisionTreeClassifier::binary_classes(const Dataset& data) {
+    std::vector<uint8_t> classes(data.rows());
+    for (size_t r = 0; r < data.rows(); ++r) classes[r] = static_cast<int>(data.label(r)) == 0 ? 0 : 1;
+    return classes;
+}
+
+void DecisionTreeClassifier::grow(const Dataset& data, const BinnedMatrix* bins,
+                                  const std::vector<uint8_t>& classes, std::vector<uint32_t> rows) {
+
+    FeatureSampler features(data.cols(), max_features_, has_seed_ ? seed_ : std::random_device{}());
+
+    if (bins) {
+        HistogramGrower grower(*bins, classes, std::move(rows), MAX_DEPTH, MIN_SAMPLES_SPLIT, features);
+        root = grower.grow();
+    } else {
+        ExactGrower grower(data, classes, std::move(rows), MAX_DEPTH, MIN_SAMPLES_SPLIT, features);
+        root = grower.grow();
+    }
+
+    num_features_ = data.cols();
+    flatten();
+}
+
+void DecisionTreeClassifier::flatten() {
+
+    flat_.clear();
+    flat_class_.clear();
+    flat_depth_ = 0;
+    if (!root) return;
+
+    // Breadth-first: a node's children are appended together, so they are adjacent
+    std::vector<std::pair<const TreeNode*, int>> queue = { { root.get(), 0 } };
+    for (size_t i = 0; i < queue.size(); ++i) {
+
+        const TreeNode* node = queue[i].first;
+        const int depth = queue[i].second;
+        const uint32_t self = static_cast<uint32_t>(i);
+
+        FlatNode flat = { 0, 0, { self, self } };
+        if (node->is_leaf) {
+            flat_depth_ = std::max(flat_depth_, depth);
+        } else {
+            const uint32_t left = static_cast<uint32_t>(queue.size());
+            flat = { node->threshold, static_cast<uint32_t>(node->feature_index), { left, left + 1 } };
+            queue.push_back({ node->left.get(), depth + 1 });
+            queue.push_back({ node->right.get(), depth + 1 });
+        }
+        flat_.push_back(flat);
+        flat_class_.push_back(node->class_label);
+    }
+}
+
+int DecisionTreeClassifier::predict(const DataPoint& point) const {
+    return predict(point.features.data());
+}
+
+int DecisionTreeClassifier::predict(const real* features) const {
+    if (flat_.empty()) throw std::runtime_error("DecisionTreeClassifier has not been trained.");
+
+    uint32_t at = 0;
+    while (flat_[at].child[0] != at) {
+        const FlatNode& node = flat_[at];
+        at = node.child[!(features[node.feature] < node.threshold)];
+    }
+    return flat_class_[at];
 }
 
 void DecisionTreeClassifier::print_tree() const {
@@ -119,13 +478,41 @@ void DecisionTreeClassifier::print_node(const TreeNode* node, int depth) const {
 }
 
 std::vector<int> DecisionTreeClassifier::predict_batch(const std::vector<DataPoint>& points) const {
-    std::vector<int> results;
-    results.reserve(points.size());
-    for (const auto& p : points) {
-        results.push_back(predict(p));
-    }
+    if (flat_.empty()) throw std::runtime_error("DecisionTreeClassifier has not been trained.");
+
+    std::vector<int> results(points.size());
+    parallel_for(points.size(), kMinPredictRows, [&](size_t, size_t begin, size_t end) {
+        walk_rows(flat_.data(), flat_class_.data(), flat_depth_, begin, end,
+                  [&](size_t r) { return points[r].features.data(); }, results.data());
+    });
+    return results;
+}
+
+std::vector<int> DecisionTreeClassifier::predict_batch(const Dataset& data) const {
+    std::vector<int> results(data.rows());
+    predict_batch(data, results.data());
     return results;
 }
 
+void DecisionTreeClassifier::predict_batch(const Dataset& data, int* out) const {
+    if (flat_.empty()) throw std::runtime_error("DecisionTreeClassifier has not been trained.");
+    if (data.cols() != num_features_) throw std::runtime_error("Feature size mismatch.");
+
+    const Dataset rows = data.as_row_major();
+    parallel_for(rows.rows(), kMinPredictRows, [&](size_t, size_t begin, size_t end) {
+        walk_rows(flat_.data(), flat_class_.data(), flat_depth_, begin, end,
+                  [&](size_t r) { return rows.row_ptr(r); }, out);
+    });
+}
+
+void DecisionTreeClassifier::predict_batch(const real* X, size_t rows, int* out) const {
+    if (flat_.empty()) throw std::runtime_error("DecisionTreeClassifier has not been trained.");
+
+    parallel_for(rows, kMinPredictRows, [&](size_t, size_t begin, size_t end) {
+        walk_rows(flat_.data(), flat_class_.data(), flat_depth_, begin, end,
+                  [&](size_t r) { return X + r * num_features_; }, out);
+    });
+}
+
 } // namespace aicpp
 
@@ -1,18 +1,23 @@
 #ifndef AI_LAB_DECISION_TREE_H
 #define AI_LAB_DECISION_TREE_H
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include "core/data_types.h"
+#include "core/dataset.h"
+#include "models/decision_tree/flat_tree.h"
 
 namespace aicpp {
 
+class BinnedMatrix;
+
 struct TreeNode {
     bool is_leaf = false;          // Leaf flag
     int class_label = -1;          // Final predicted class (for leaves)
 
     int feature_index = -1;        // Feature index to split by
-    double threshold = 0.0;        // Split threshold value
+    real threshold = 0;            // Split threshold value
 
     std::unique_ptr<TreeNode> left;  // Left subtree (feature < threshold)
     std::unique_ptr<TreeNode> right; // Right subtree (feature >= threshold)
@@ -21,37 +26,87 @@ struct TreeNode {
 class DecisionTreeClassifier {
 public:
 
-    DecisionTreeClassifier(int max_depth = 3, int min_samples_split = 2);
+    /**
+     * @brief How split thresholds are searched.
+     * * Exact: every sample value of every feature is a candidate threshold. Each node
+     *   sorts every feature once and sweeps it with running class counts, partitioning
+     *   one row index array in place; O(F·N log N) per tree level, O(N) extra memory.
+     * * Histogram: features are first quantised to at most max_bins quantile bins
+     *   (uint8_t codes, see BinnedMatrix) and splits are read off per-node class
+     *   histograms, O(F·N) per node. Only the smaller child's histogram is built;
+     *   the larger one is the parent's minus its sibling's. Thresholds are bin cuts,
+     *   so prediction still works on raw features. When no feature has more than
+     *   max_bins distinct values the candidates are the same as Exact's; only ties
+     *   between equally good thresholds may resolve differently.
+     */
+    enum class Splitter { Exact, Histogram };
+
+    DecisionTreeClassifier(int max_depth = 3, int min_samples_split = 2,
+                           Splitter splitter = Splitter::Exact, int max_bins = 256);
     
+    /**
+     * @brief Number of features, drawn at random for every node, that the node may
+     * split on; 0 (the default) searches all of them. Draws follow set_seed, or
+     * std::random_device when no seed is set.
+     */
+    void set_max_features(int max_features);
+    void set_seed(uint64_t seed);
+
     // Tree output
     void print_tree() const;
 
     // Train the tree on dataset
     void train(std::vector<DataPoint>& data);
+    void train(const Dataset& data);
 
     // Predict class for a single data point
     int predict(const DataPoint& point) const;
+    int predict(const real* features) const;
 
-    // Batch prediction
+    // Batch prediction: rows walk the flattened tree 16 at a time, split across the pool
     std::vector<int> predict_batch(const std::vector<DataPoint>& points) const;
+    std::vector<int> predict_batch(const Dataset& data) const;
+    void predict_batch(const Dataset& data, int* out) const;
+
+    // Same, for `rows` contiguous row-major rows with the training feature count
+    void predict_batch(const real* X, size_t rows, int* out) const;
 
 private:
     std::unique_ptr<TreeNode> root;  // Root of the decision tree
     int MAX_DEPTH;
     int MIN_SAMPLES_SPLIT;
+    Splitter splitter_;
+    int max_bins_;
+    int max_features_ = 0;
+    bool has_seed_ = false;
+    uint64_t seed_ = 0;
+    size_t num_features_ = 0;
+
+    // The trained tree compiled for inference, one node per TreeNode in breadth-first
+    // order (siblings adjacent); the class of each leaf is in flat_class_
+    std::vector<FlatNode> flat_;
+    std::vector<int> flat_class_;
+    int flat_depth_ = 0;  // depth of the deepest leaf
+
+    // Rebuilds flat_ from root after training
+    void flatten();
 
     // Node outout
     void print_node(const TreeNode* node, int depth) const;
 
-    // Recursive tree builder
-    std::unique_ptr<TreeNode> build_tree(std::vector<DataPoint>& data, int depth);
+    friend class RandomForestClassifier;
+
+    // Shared by both train() overloads; classes[r] is 0 or 1
+    void train(const Dataset& data, const std::vector<uint8_t>& classes);
 
-    // Gini impurity measure
-    double gini_impurity(const std::vector<DataPoint>& data);
+    // 0 for label 0 and 1 for any other label, as the tree has always separated them
+    static std::vector<uint8_t> binary_classes(const Dataset& data);
 
-    // Weighted cost for split
-    double compute_split_cost(const std::vector<DataPoint>& left,
-                              const std::vector<DataPoint>& right);
+    // Grows the tree on rows[] of data (repeats allowed, e.g. a bootstrap sample)
+    // without copying any of it. bins is data binned for Splitter::Histogram, or null
+    // for the exact search.
+    void grow(const Dataset& data, const BinnedMatrix* bins,
+              const std::vector<uint8_t>& classes, std::vector<uint32_t> rows);
 };
 
 } // namespace aicpp
@@ -0,0 +1,43 @@
+#ifndef AI_LAB_FLAT_TREE_H
+#define AI_LAB_FLAT_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "core/data_types.h"
+
+namespace aicpp {
+
+/**
+ * @brief Node of a tree compiled for inference. child[0] is taken when
+ * x[feature] < threshold and child[1] otherwise; a leaf points to itself, so
+ * further steps leave a row where it is. Root is node 0.
+ */
+struct FlatNode {
+    real threshold;
+    uint32_t feature;
+    uint32_t child[2];
+};
+
+// Rows that descend a flat tree together
+constexpr size_t kFlatLanes = 16;
+
+/**
+ * @brief Moves rows x[0..m) (m <= kFlatLanes) from the root down `depth` levels and
+ * writes the node each one ends on to at[]. Every lane takes one step per round, so
+ * the node loads of different rows are independent and overlap in memory. The step
+ * selects the child index from the comparison instead of branching; with depth at
+ * least the deepest leaf's, every row ends on its leaf.
+ */
+inline void descend(const FlatNode* nodes, int depth, const real* const* x, size_t m, uint32_t* at) {
+    for (size_t l = 0; l < m; ++l) at[l] = 0;
+    for (int d = 0; d < depth; ++d) {
+        for (size_t l = 0; l < m; ++l) {
+            const FlatNode& node = nodes[at[l]];
+            at[l] = node.child[!(x[l][node.feature] < node.threshold)];
+        }
+    }
+}
+
+} // namespace aicpp
+
+#endif // AI_LAB_FLAT_TREE_H
@@ -0,0 +1,451 @@
+#include "models/decision_tree/gradient_boosting.h"
+#include "core/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace aicpp {
+
+namespace {
+
+// Rows per chunk of the gradient pass and of a histogram fill
+const size_t kMinRowsPerChunk = size_t(1) << 14;
+
+// Fewest rows per prediction chunk
+const size_t kMinPredictRows = 4096;
+
+// A child needs at least this much hessian, so that nearly pure logistic leaves
+// do not get extreme values
+const double kMinChildHessian = 1e-3;
+
+// Splits must improve the objective by more than this
+const double kMinGain = 1e-12;
+
+double sigmoid(double z) {
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+// log(1 + e^z) - y·z without overflow for large |z|
+double logistic_loss(double z, double y) {
+    return std::max(z, 0.0) + std::log1p(std::exp(-std::fabs(z))) - y * z;
+}
+
+} // namespace
+
+GradientBoostedTrees::GradientBoostedTrees(Loss loss, int n_trees, double learning_rate, int max_leaves)
+    : loss_(loss), n_trees_(std::max(0, n_trees)), learning_rate_(learning_rate),
+      max_leaves_(std::max(2, max_leaves)) {}
+
+void GradientBoostedTrees::set_tree_limits(int max_depth, int min_samples_leaf) {
+    max_depth_ = std::max(0, max_depth);
+    min_samples_leaf_ = std::max(1, min_samples_leaf);
+}
+
+void GradientBoostedTrees::set_l2_regularization(double l2) {
+    l2_ = std::max(0.0, l2);
+}
+
+void GradientBoostedTrees::set_max_bins(int max_bins) {
+    max_bins_ = max_bins;
+}
+
+// --- Training ---
+void GradientBoostedTrees::train(const Dataset& data) {
+
+    if (!data.has_labels()) throw std::runtime_error("Dataset must have a label array.");
+    if (data.rows() == 0 || data.cols() == 0) throw std::runtime_error("Dataset is empty.");
+    if (data.rows() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("GradientBoostedTrees supports at most 2^32 - 1 rows.");
+    }
+
+    const size_t n = data.rows();
+    num_features_ = data.cols();
+
+    std::cout << "Starting Gradient Boosting training ("
+              << (loss_ == Loss::Logistic ? "logistic" : "squared") << " loss, "
+              << n_trees_ << " trees, " << max_leaves_ << " leaves)..." << std::endl;
+
+    BinnedMatrix bins;
+    bins.build(data, max_bins_, Layout::RowMajor);
+    bins_ = &bins;
+
+    offsets_.assign(bins.cols() + 1, 0);
+    for (size_t f = 0; f < bins.cols(); ++f) offsets_[f + 1] = offsets_[f] + bins.bins(f);
+
+    // Logistic targets separate label 0 from the rest, like DecisionTreeClassifier
+    std::vector<double> y(n);
+    double mean = 0.0;
+    for (size_t r = 0; r < n; ++r) {
+        y[r] = loss_ == Loss::Logistic ? (static_cast<int>(data.label(r)) == 0 ? 0.0 : 1.0) : data.label(r);
+        mean += y[r];
+    }
+    mean /= n;
+
+    if (loss_ == Loss::Logistic) {
+        double p = std::min(std::max(mean, 1e-6), 1.0 - 1e-6);
+        base_score_ = std::log(p / (1.0 - p));
+    } else {
+        base_score_ = mean;
+    }
+
+    index_.resize(n);
+    scratch_.resize(n);
+    grad_.resize(n);
+    hess_.resize(n);
+    node_grad_.resize(n);
+    node_hess_.resize(n);
+    slots_.clear();
+    free_slots_.clear();
+
+    std::vector<double> scores(n, base_score_);
+    std::vector<double> partial_loss(parallel_chunks(n, kMinRowsPerChunk));
+    trees_.clear();
+    trees_.reserve(n_trees_);
+
+    for (int round = 0; round <= n_trees_; ++round) {
+
+        // Gradient and hessian of the loss at the current scores, plus the loss itself
+        parallel_for(n, kMinRowsPerChunk, [&](size_t chunk, size_t begin, size_t end) {
+            double loss = 0.0;
+            for (size_t r = begin; r < end; ++r) {
+                if (loss_ == Loss::Logistic) {
+                    double p = sigmoid(scores[r]);
+                    grad_[r] = p - y[r];
+                    hess_[r] = p * (1.0 - p);
+                    loss += logistic_loss(scores[r], y[r]);
+                } else {
+                    grad_[r] = scores[r] - y[r];
+                    hess_[r] = 1.0;
+                    loss += grad_[r] * grad_[r];
+                }
+            }
+            partial_loss[chunk] = loss;
+        });
+
+        if (round % 10 == 0 || round == n_trees_) {
+            double loss = 0.0;
+            for (double l : partial_loss) loss += l;
+            std::cout << "Round " << std::setw(4) << std::left << round
+                      << " | Loss: " << std::fixed << std::setprecision(5) << loss / n << std::endl;
+        }
+
+        if (round == n_trees_) break;
+        trees_.push_back(grow_tree(scores));
+    }
+
+    // Release the training state; only the trees are kept
+    bins_ = nullptr;
+    std::vector<uint32_t>().swap(index_);
+    std::vector<uint32_t>().swap(scratch_);
+    std::vector<double>().swap(grad_);
+    std::vector<double>().swap(hess_);
+    std::vector<double>().swap(node_grad_);
+    std::vector<double>().swap(node_hess_);
+    slots_.clear();
+    free_slots_.clear();
+    partials_.clear();
+
+    std::cout << "Gradient Boosting training finished." << std::endl;
+}
+
+int GradientBoostedTrees::acquire_slot() {
+    if (!free_slots_.empty()) {
+        int slot = free_slots_.back();
+        free_slots_.pop_back();
+        return slot;
+    }
+    slots_.emplace_back(offsets_.back());
+    return static_cast<int>(slots_.size()) - 1;
+}
+
+/**
+ * @brief Histogram of rows index_[begin, end). The node's gradients are first
+ * gathered into index_ order, and every row then adds itself to the bin of each
+ * feature, reading its codes from one row-major line. Large nodes are split into
+ * row blocks, each filling a private histogram, which are then summed feature by
+ * feature.
+ */
+void GradientBoostedTrees::fill_histogram(size_t begin, size_t end, std::vector<GradientSum>& h) {
+
+    const size_t n = end - begin;
+    const size_t cols = bins_->cols();
+    const size_t* offsets = offsets_.data();
+
+    parallel_for(n, kMinRowsPerChunk, [&](size_t, size_t b, size_t e) {
+        for (size_t i = begin + b; i < begin + e; ++i) {
+            node_grad_[i] = grad_[index_[i]];
+            node_hess_[i] = hess_[index_[i]];
+        }
+    });
+
+    auto fill_rows = [&](size_t b, size_t e, GradientSum* out) {
+        std::fill(out, out + offsets_.back(), GradientSum());
+        for (size_t i = b; i < e; ++i) {
+            const uint8_t* codes = bins_->row(index_[i]);
+            const double g = node_grad_[i], hs = node_hess_[i];
+            for (size_t f = 0; f < cols; ++f) {
+                GradientSum& s = out[offsets[f] + codes[f]];
+                s.grad += g;
+                s.hess += hs;
+                ++s.count;
+            }
+        }
+    };
+
+    const size_t chunks = parallel_chunks(n, kMinRowsPerChunk);
+    if (chunks <= 1) {
+        fill_rows(begin, end, h.data());
+        return;
+    }
+
+    if (partials_.size() < chunks) partials_.resize(chunks);
+    parallel_for(n, kMinRowsPerChunk, [&](size_t chunk, size_t b, size_t e) {
+        partials_[chunk].resize(offsets_.back());
+        fill_rows(begin + b, begin + e, partials_[chunk].data());
+    });
+
+    parallel_for(cols, 1, [&](size_t, size_t f0, size_t f1) {
+        for (size_t k = offsets_[f0]; k < offsets_[f1]; ++k) {
+            GradientSum s;
+            for (size_t c = 0; c < chunks; ++c) {
+                s.grad += partials_[c][k].grad;
+                s.hess += partials_[c][k].hess;
+                s.count += partials_[c][k].count;
+            }
+            h[k] = s;
+        }
+    });
+}
+
+/**
+ * @brief Best split of a leaf from its histogram: every bin boundary of every
+ * feature, scored by the second-order gain G_L²/(H_L+λ) + G_R²/(H_R+λ) − G²/(H+λ).
+ * Like the classifier, a boundary is a candidate only before an occupied bin.
+ */
+void GradientBoostedTrees::find_split(Leaf& leaf) const {
+
+    const std::vector<GradientSum>& h = slots_[leaf.slot];
+    const GradientSum& total = leaf.sum;
+    const double parent = total.grad * total.grad / (total.hess + l2_);
+    const uint32_t min_leaf = static_cast<uint32_t>(min_samples_leaf_);
+
+    Split best;
+    best.gain = kMinGain;
+
+    for (size_t f = 0; f < bins_->cols(); ++f) {
+
+        const GradientSum* sums = h.data() + offsets_[f];
+        GradientSum left;
+        for (int b = 0; b + 1 < bins_->bins(f); ++b) {
+
+            left.grad += sums[b].grad;
+            left.hess += sums[b].hess;
+            left.count += sums[b].count;
+
+            if (left.count < min_leaf) continue;
+            if (total.count - left.count < min_leaf) break;
+            if (sums[b + 1].count == 0) continue;
+
+            const double right_grad = total.grad - left.grad;
+            const double right_hess = total.hess - left.hess;
+            if (left.hess < kMinChildHessian || right_hess < kMinChildHessian) continue;
+
+            double gain = left.grad * left.grad / (left.hess + l2_)
+                        + right_grad * right_grad / (right_hess + l2_) - parent;
+            if (gain > best.gain) {
+                best.gain = gain;
+                best.feature = static_cast<int>(f);
+                best.bin = b;
+                best.left = left;
+            }
+        }
+    }
+
+    leaf.split = best;
+}
+
+double GradientBoostedTrees::leaf_value(const GradientSum& s) const {
+    return -learning_rate_ * s.grad / (s.hess + l2_);
+}
+
+GradientBoostedTrees::Tree GradientBoostedTrees::grow_tree(std::vector<double>& scores) {
+
+    Tree tree;
+    tree.nodes.push_back({ 0, 0, { 0, 0 } });
+    tree.values.push_back(0.0);
+
+    free_slots_.clear();
+    for (size_t s = slots_.size(); s-- > 0; ) free_slots_.push_back(static_cast<int>(s));
+
+    // Every tree starts from rows in ascending order; the previous tree left them grouped by leaf
+    for (size_t r = 0; r < index_.size(); ++r) index_[r] = static_cast<uint32_t>(r);
+
+    const size_t min_split_rows = 2 * static_cast<size_t>(min_samples_leaf_);
+    auto can_split = [&](const Leaf& leaf) {
+        return (max_depth_ == 0 || leaf.depth < max_depth_) && leaf.end - leaf.begin >= min_split_rows;
+    };
+
+    std::vector<Leaf> open, done;
+
+    Leaf root = { 0, index_.size(), 0, 0, GradientSum(), -1, Split() };
+    root.slot = acquire_slot();
+    fill_histogram(root.begin, root.end, slots_[root.slot]);
+    for (size_t k = offsets_[0]; k < offsets_[1]; ++k) {
+        root.sum.grad += slots_[root.slot][k].grad;
+        root.sum.hess += slots_[root.slot][k].hess;
+        root.sum.count += slots_[root.slot][k].count;
+    }
+    if (can_split(root)) find_split(root);
+    if (root.split.feature >= 0) {
+        open.push_back(root);
+    } else {
+        free_slots_.push_back(root.slot);
+        done.push_back(root);
+    }
+
+    // Leaf-wise: always split the open leaf with the largest gain
+    int leaves = 1;
+    while (!open.empty() && leaves < max_leaves_) {
+
+        size_t pick = 0;
+        for (size_t i = 1; i < open.size(); ++i) {
+            if (open[i].split.gain > open[pick].split.gain) pick = i;
+        }
+        Leaf parent = open[pick];
+        open[pick] = open.back();
+        open.pop_back();
+
+        const Split& split = parent.split;
+        // Stable, so every leaf's rows stay in ascending order and the histogram
+        // fills read the row-major codes front to back
+        size_t mid = parent.begin, spilled = 0;
+        for (size_t i = parent.begin; i < parent.end; ++i) {
+            const uint32_t r = index_[i];
+            if (bins_->row(r)[split.feature] <= split.bin) index_[mid++] = r;
+            else scratch_[spilled++] = r;
+        }
+        std::copy(scratch_.begin(), scratch_.begin() + spilled, index_.begin() + mid);
+
+        const uint32_t first = static_cast<uint32_t>(tree.nodes.size());
+        tree.nodes[parent.node] = { bins_->threshold(split.feature, split.bin),
+                                    static_cast<uint32_t>(split.feature), { first, first + 1 } };
+        tree.nodes.push_back({ 0, 0, { first, first } });
+        tree.nodes.push_back({ 0, 0, { first + 1, first + 1 } });
+        tree.values.push_back(0.0);
+        tree.values.push_back(0.0);
+        ++leaves;
+
+        GradientSum right;
+        right.grad = parent.sum.grad - split.left.grad;
+        right.hess = parent.sum.hess - split.left.hess;
+        right.count = parent.sum.count - split.left.count;
+
+        Leaf children[2] = {
+            { parent.begin, mid, parent.depth + 1, first, split.left, -1, Split() },
+            { mid, parent.end, parent.depth + 1, first + 1, right, -1, Split() }
+        };
+
+        // Histograms only if a child may still split: the smaller child's is counted
+        // and the larger child takes over the parent's buffer minus it
+        if (leaves < max_leaves_ && (can_split(children[0]) || can_split(children[1]))) {
+            const int small = (mid - parent.begin <= parent.end - mid) ? 0 : 1;
+            children[small].slot = acquire_slot();
+            children[1 - small].slot = parent.slot;
+
+            std::vector<GradientSum>& small_hist = slots_[children[small].slot];
+            std::vector<GradientSum>& large_hist = slots_[parent.slot];
+            fill_histogram(children[small].begin, children[small].end, small_hist);
+            for (size_t k = 0; k < large_hist.size(); ++k) {
+                large_hist[k].grad -= small_hist[k].grad;
+                large_hist[k].hess -= small_hist[k].hess;
+                large_hist[k].count -= small_hist[k].count;
+            }
+        } else {
+            free_slots_.push_back(parent.slot);
+        }
+
+        for (Leaf& child : children) {
+            if (child.slot >= 0 && can_split(child)) find_split(child);
+            if (child.split.feature >= 0) {
+                open.push_back(child);
+            } else {
+                if (child.slot >= 0) free_slots_.push_back(child.slot);
+                done.push_back(child);
+            }
+        }
+    }
+    done.insert(done.end(), open.begin(), open.end());
+
+    // Leaf outputs, applied to the training scores through the leaves' row ranges
+    for (const Leaf& leaf : done) {
+        tree.values[leaf.node] = leaf_value(leaf.sum);
+        tree.depth = std::max(tree.depth, leaf.depth);
+    }
+    parallel_for(done.size(), 1, [&](size_t, size_t l0, size_t l1) {
+        for (size_t l = l0; l < l1; ++l) {
+            const double value = tree.values[done[l].node];
+            for (size_t i = done[l].begin; i < done[l].end; ++i) scores[index_[i]] += value;
+        }
+    });
+
+    return tree;
+}
+
+// --- Prediction ---
+double GradientBoostedTrees::raw_score(const real* features) const {
+    double score = base_score_;
+    for (const Tree& tree : trees_) {
+        uint32_t at = 0;
+        while (tree.nodes[at].child[0] != at) {
+            const FlatNode& node = tree.nodes[at];
+            at = node.child[!(features[node.feature] < node.threshold)];
+        }
+        score += tree.values[at];
+    }
+    return score;
+}
+
+double GradientBoostedTrees::predict(const real* features) const {
+    if (num_features_ == 0) throw std::runtime_error("GradientBoostedTrees has not been trained.");
+    double score = raw_score(features);
+    return loss_ == Loss::Logistic ? sigmoid(score) : score;
+}
+
+void GradientBoostedTrees::predict_batch(const Dataset& X, double* out) const {
+
+    if (num_features_ == 0) throw std::runtime_error("GradientBoostedTrees has not been trained.");
+    if (X.cols() != num_features_) throw std::runtime_error("Feature size mismatch.");
+
+    const Dataset rows = X.as_row_major();
+
+    // Each block of rows descends every tree before the next block starts
+    parallel_for(rows.rows(), kMinPredictRows, [&](size_t, size_t begin, size_t end) {
+
+        const real* x[kFlatLanes];
+        uint32_t at[kFlatLanes];
+        double score[kFlatLanes];
+
+        for (size_t r0 = begin; r0 < end; r0 += kFlatLanes) {
+
+            const size_t m = std::min(kFlatLanes, end - r0);
+            for (size_t l = 0; l < m; ++l) {
+                x[l] = rows.row_ptr(r0 + l);
+                score[l] = base_score_;
+            }
+
+            for (const Tree& tree : trees_) {
+                descend(tree.nodes.data(), tree.depth, x, m, at);
+                for (size_t l = 0; l < m; ++l) score[l] += tree.values[at[l]];
+            }
+
+            for (size_t l = 0; l < m; ++l) {
+                out[r0 + l] = loss_ == Loss::Logistic ? sigmoid(score[l]) : score[l];
+            }
+        }
+    });
+}
+
+} // namespace aicpp
@@ -0,0 +1,128 @@
+#ifndef AI_LAB_GRADIENT_BOOSTING_H
+#define AI_LAB_GRADIENT_BOOSTING_H
+
+#include <cstdint>
+#include <vector>
+#include "core/data_types.h"
+#include "core/dataset.h"
+#include "core/binning.h"
+#include "models/decision_tree/flat_tree.h"
+
+namespace aicpp {
+
+/**
+ * @brief Gradient-boosted regression trees on binned features.
+ * * Every round fits one tree to the gradient and hessian of the loss at the current
+ * predictions (a Newton step), shrunk by the learning rate. Features are quantised
+ * once into at most 256 quantile bins (BinnedMatrix). Trees grow leaf-wise: the
+ * leaf with the largest gain is split next, until max_leaves leaves. A node's split
+ * comes from its gradient/hessian histogram. Only the smaller child's histogram is
+ * built, and the larger child's is the parent's minus it. A fill splits the rows
+ * into blocks across the thread pool, and the block histograms are summed in
+ * parallel across features.
+ */
+class GradientBoostedTrees {
+public:
+
+    /**
+     * @brief Squared: regression on the labels, loss ½(y − f)².
+     * * Logistic: binary classification of label 0 against the rest, log-loss on
+     *   the log-odds f; predictions are probabilities of the non-zero class.
+     */
+    enum class Loss { Squared, Logistic };
+
+    GradientBoostedTrees(Loss loss = Loss::Logistic, int n_trees = 100,
+                         double learning_rate = 0.1, int max_leaves = 31);
+
+    /**
+     * @brief Limits on every tree: max_depth (0 = none) and the fewest training rows
+     * a leaf may hold. Defaults: no depth limit, 20 rows.
+     */
+    void set_tree_limits(int max_depth, int min_samples_leaf);
+
+    // L2 penalty on leaf values, added to each leaf's hessian sum (default 1)
+    void set_l2_regularization(double l2);
+
+    void set_max_bins(int max_bins);
+
+    void train(const Dataset& data);
+
+    // Regression value (Squared) or probability of the non-zero class (Logistic)
+    double predict(const real* features) const;
+
+    // Same for every row of X into out[0..X.rows()), row blocks split across the pool
+    void predict_batch(const Dataset& X, double* out) const;
+
+    size_t size() const { return trees_.size(); }
+
+private:
+
+    // Leaves point to themselves; value is the leaf output (0 for inner nodes)
+    struct Tree {
+        std::vector<FlatNode> nodes;
+        std::vector<double> values;
+        int depth = 0;
+    };
+
+    // Sums of one histogram bin (or of a whole node)
+    struct GradientSum {
+        double grad = 0.0;
+        double hess = 0.0;
+        uint32_t count = 0;
+    };
+
+    struct Split {
+        double gain = 0.0;
+        int feature = -1;
+        int bin = -1;
+        GradientSum left;
+    };
+
+    // A leaf of the tree being grown: rows index_[begin, end), its sums, the slot
+    // holding its histogram and the best split found for it
+    struct Leaf {
+        size_t begin, end;
+        int depth;
+        uint32_t node;
+        GradientSum sum;
+        int slot;
+        Split split;
+    };
+
+    Loss loss_;
+    int n_trees_;
+    double learning_rate_;
+    int max_leaves_;
+    int max_depth_ = 0;
+    int min_samples_leaf_ = 20;
+    double l2_ = 1.0;
+    int max_bins_ = BinnedMatrix::kMaxBins;
+
+    double base_score_ = 0.0;
+    size_t num_features_ = 0;
+    std::vector<Tree> trees_;
+
+    // Training state, alive only during train()
+    const BinnedMatrix* bins_ = nullptr;
+    std::vector<size_t> offsets_;                     // first bin of each feature in a histogram
+    std::vector<uint32_t> index_;                     // row permutation; leaves own ascending ranges of it
+    std::vector<uint32_t> scratch_;                   // right-hand rows during a partition
+    std::vector<double> grad_, hess_;                 // per row
+    std::vector<double> node_grad_, node_hess_;       // gathered in index_ order for the node being filled
+    std::vector<std::vector<GradientSum>> slots_;     // histogram buffers, one per open leaf
+    std::vector<int> free_slots_;
+    std::vector<std::vector<GradientSum>> partials_;  // per-chunk histograms of a row-split fill
+
+    Tree grow_tree(std::vector<double>& scores);
+    void fill_histogram(size_t begin, size_t end, std::vector<GradientSum>& h);
+    void find_split(Leaf& leaf) const;
+    double leaf_value(const GradientSum& s) const;
+    int acquire_slot();
+
+    // Sum of the tree outputs for one row, before the link function
+    double raw_score(const real* features) const;
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_GRADIENT_BOOSTING_H
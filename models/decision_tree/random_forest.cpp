@@ -0,0 +1,134 @@
+#include "models/decision_tree/random_forest.h"
+#include "core/binning.h"
+#include "core/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+namespace aicpp {
+
+namespace {
+
+// Rows per voting block; every tree walks the block before the next block starts
+const size_t kVoteBlock = 256;
+
+} // namespace
+
+RandomForestClassifier::RandomForestClassifier(int n_trees, int max_depth, int min_samples_split,
+                                               DecisionTreeClassifier::Splitter splitter, int max_features)
+    : n_trees_(std::max(1, n_trees)), max_depth_(max_depth), min_samples_split_(min_samples_split),
+      splitter_(splitter), max_features_(max_features) {}
+
+void RandomForestClassifier::set_seed(uint64_t seed) {
+    has_seed_ = true;
+    seed_ = seed;
+}
+
+void RandomForestClassifier::train(const Dataset& data) {
+
+    if (!data.has_labels()) throw std::runtime_error("Dataset must have a label array.");
+    if (data.rows() == 0) throw std::runtime_error("Dataset is empty.");
+    if (data.rows() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("RandomForestClassifier supports at most 2^32 - 1 rows.");
+    }
+
+    const size_t n = data.rows();
+    num_features_ = data.cols();
+    const int max_features = max_features_ > 0
+        ? max_features_
+        : std::max(1, static_cast<int>(std::lround(std::sqrt(static_cast<double>(data.cols())))));
+
+    std::cout << "--- Random Forest Training Started (" << n_trees_ << " trees, max_features="
+              << max_features << ") ---" << std::endl;
+
+    // Shared, read-only inputs of every tree
+    const std::vector<uint8_t> classes = DecisionTreeClassifier::binary_classes(data);
+    BinnedMatrix bins;
+    if (splitter_ == DecisionTreeClassifier::Splitter::Histogram) bins.build(data);
+
+    std::vector<uint64_t> seeds(n_trees_);
+    std::random_device rd;
+    for (int i = 0; i < n_trees_; ++i) seeds[i] = has_seed_ ? seed_ + i : rd();
+
+    trees_.clear();
+    trees_.reserve(n_trees_);
+    for (int i = 0; i < n_trees_; ++i) {
+        trees_.emplace_back(max_depth_, min_samples_split_, splitter_);
+        trees_.back().set_max_features(max_features);
+    }
+
+    // One tree per task; the splits inside a tree run inline on its worker
+    ThreadPool::instance().run(n_trees_, [&](size_t i) {
+
+        std::mt19937_64 rng(seeds[i]);
+        std::uniform_int_distribution<uint32_t> draw(0, static_cast<uint32_t>(n - 1));
+
+        // Sorted bootstrap indices keep the row accesses roughly sequential
+        std::vector<uint32_t> rows(n);
+        for (uint32_t& r : rows) r = draw(rng);
+        std::sort(rows.begin(), rows.end());
+
+        DecisionTreeClassifier& tree = trees_[i];
+        tree.set_seed(rng());
+        tree.grow(data, splitter_ == DecisionTreeClassifier::Splitter::Histogram ? &bins : nullptr,
+                  classes, std::move(rows));
+    });
+
+    std::cout << "Random Forest training finished." << std::endl;
+}
+
+int RandomForestClassifier::predict(const real* features) const {
+    if (trees_.empty()) throw std::runtime_error("RandomForestClassifier has not been trained.");
+
+    size_t votes = 0;
+    for (const auto& tree : trees_) votes += tree.predict(features);
+    return 2 * votes > trees_.size() ? 1 : 0;
+}
+
+void RandomForestClassifier::count_votes(const Dataset& X, std::vector<int>& votes) const {
+
+    if (trees_.empty()) throw std::runtime_error("RandomForestClassifier has not been trained.");
+    if (X.cols() != num_features_) throw std::runtime_error("Feature size mismatch.");
+
+    const Dataset rows = X.as_row_major();
+    votes.assign(rows.rows(), 0);
+
+    parallel_for(rows.rows(), kVoteBlock, [&](size_t, size_t begin, size_t end) {
+
+        int labels[kVoteBlock];
+        for (size_t r0 = begin; r0 < end; r0 += kVoteBlock) {
+
+            const size_t m = std::min(kVoteBlock, end - r0);
+            const Dataset block = Dataset::view(rows.row_ptr(r0), m, rows.cols(), Layout::RowMajor,
+                                                nullptr, nullptr, rows.leading_dim());
+
+            // Nested inside the pool, so each tree walks the block inline
+            for (const auto& tree : trees_) {
+                tree.predict_batch(block, labels);
+                for (size_t i = 0; i < m; ++i) votes[r0 + i] += labels[i];
+            }
+        }
+    });
+}
+
+std::vector<int> RandomForestClassifier::predict_batch(const Dataset& X) const {
+    std::vector<int> results(X.rows());
+    predict_batch(X, results.data());
+    return results;
+}
+
+void RandomForestClassifier::predict_batch(const Dataset& X, int* out) const {
+    std::vector<int> votes;
+    count_votes(X, votes);
+    for (size_t r = 0; r < votes.size(); ++r) out[r] = 2 * static_cast<size_t>(votes[r]) > trees_.size() ? 1 : 0;
+}
+
+void RandomForestClassifier::predict_proba_batch(const Dataset& X, double* out) const {
+    std::vector<int> votes;
+    count_votes(X, votes);
+    for (size_t r = 0; r < votes.size(); ++r) out[r] = static_cast<double>(votes[r]) / trees_.size();
+}
+
+} // namespace aicpp
@@ -0,0 +1,69 @@
+#ifndef AI_LAB_RANDOM_FOREST_H
+#define AI_LAB_RANDOM_FOREST_H
+
+#include <cstdint>
+#include <vector>
+#include "core/data_types.h"
+#include "core/dataset.h"
+#include "models/decision_tree/decision_tree.h"
+
+namespace aicpp {
+
+/**
+ * @brief Bagged ensemble of DecisionTreeClassifier trees voting on label 0 vs the rest.
+ * * Every tree grows on a bootstrap sample of N rows drawn with replacement. The
+ * sample is an array of row indices into the shared training data, never a copy of
+ * it. Every node searches only max_features randomly chosen features. Trees train
+ * concurrently on the thread pool, one tree per task. With Splitter::Histogram the
+ * features are binned once and the bins are shared by all trees.
+ */
+class RandomForestClassifier {
+public:
+
+    // max_features = 0 uses round(sqrt(number of features))
+    RandomForestClassifier(int n_trees = 100, int max_depth = 10, int min_samples_split = 2,
+                           DecisionTreeClassifier::Splitter splitter = DecisionTreeClassifier::Splitter::Histogram,
+                           int max_features = 0);
+
+    /**
+     * @brief Fixes the seed of the bootstrap samples and feature draws. Tree i uses
+     * seed + i, so the forest does not depend on the thread count. Without it
+     * every train() is seeded from std::random_device.
+     */
+    void set_seed(uint64_t seed);
+
+    void train(const Dataset& data);
+
+    // Majority vote; a tie predicts class 0
+    int predict(const real* features) const;
+
+    // Votes for every row of X, row blocks split across the pool
+    std::vector<int> predict_batch(const Dataset& X) const;
+    void predict_batch(const Dataset& X, int* out) const;
+
+    // Fraction of trees voting for class 1, per row
+    void predict_proba_batch(const Dataset& X, double* out) const;
+
+    size_t size() const { return trees_.size(); }
+    const DecisionTreeClassifier& tree(size_t i) const { return trees_[i]; }
+
+private:
+
+    int n_trees_;
+    int max_depth_;
+    int min_samples_split_;
+    DecisionTreeClassifier::Splitter splitter_;
+    int max_features_;
+    bool has_seed_ = false;
+    uint64_t seed_ = 0;
+    size_t num_features_ = 0;
+
+    std::vector<DecisionTreeClassifier> trees_;
+
+    // Number of trees voting for class 1 on every row of X
+    void count_votes(const Dataset& X, std::vector<int>& votes) const;
+};
+
+} // namespace aicpp
+
+#endif // AI_LAB_RANDOM_FOREST_H
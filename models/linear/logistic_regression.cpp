@@ -1,4 +1,10 @@
 #include "logistic_regression.h"
+#include "../../core/linalg.h"
+#include "../../core/linear_batch.h"
+#include "../../core/simd.h"
+#include "../../core/thread_pool.h"
+#include "../../data/preprocessing/dataset_stream.h"
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <numeric>
@@ -9,14 +15,263 @@
 
 namespace aicpp {
 
+namespace {
+
+// Minimum multiply-adds per parallel chunk; smaller batches stay on one thread
+const size_t kMinWorkPerChunk = 1 << 15;
+
+// Fewest rows per chunk when a mini-batch is spread over the pool
+const size_t kMinBatchRows = 32;
+
+// Fixed so that mini-batch order is reproducible between runs
+const unsigned kShuffleSeed = 42;
+
+// Curvature pairs kept by L-BFGS
+const size_t kLbfgsHistory = 10;
+
+// Armijo sufficient-decrease constant and step halvings tried per line search
+const double kArmijo = 1e-4;
+const int kMaxLineSearch = 40;
+
+// Times the Newton damping is raised (tenfold each) before giving up on the Hessian
+const int kMaxDamping = 20;
+
+// FTRL-Proximal β: smooths the per-feature step size alpha / (β + √n) for early updates
+const double kFtrlBeta = 1.0;
+
+// Closed-form FTRL-Proximal weight for one coordinate
+double ftrl_weight(double z, double n, double alpha, double l1, double l2) {
+    if (std::fabs(z) <= l1) return 0.0;
+    return -(z - std::copysign(l1, z)) / ((kFtrlBeta + std::sqrt(n)) / alpha + l2);
+}
+
+// log(1 + e^z) - y·z without overflow for large |z|
+double log_loss(double z, double y) {
+    return std::max(z, 0.0) + std::log1p(std::exp(-std::fabs(z))) - y * z;
+}
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double s = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) s += a[i] * b[i];
+    return s;
+}
+
+// Largest magnitude in a, or NaN if a holds one
+double max_abs(const std::vector<double>& a) {
+    double m = 0.0;
+    for (double v : a) {
+        if (std::isnan(v)) return v;
+        m = std::max(m, std::fabs(v));
+    }
+    return m;
+}
+
+// A non-finite loss or gradient means the data holds NaN or infinite values
+void check_finite(double loss, const std::vector<double>& grad) {
+    if (!std::isfinite(loss) || !std::isfinite(max_abs(grad))) {
+        throw std::runtime_error("Non-finite loss or gradient; check the training data for NaN or infinite values.");
+    }
+}
+
+/**
+ * Adds the summed log-loss gradient of the rows of X at w (bias last) to grad and,
+ * if hess is non-null, the summed Hessian Σ p(1-p)·x̃x̃ᵀ (upper triangle) to hess.
+ * Rows are split over the thread pool with per-chunk buffers. Returns the summed loss.
+ */
+double add_dense_objective(const Dataset& X, const std::vector<double>& w,
+                           std::vector<double>& grad, std::vector<double>* hess) {
+
+    const size_t m = X.cols(), p = m + 1;
+    const std::vector<real> wr(w.begin(), w.begin() + m);
+    const size_t min_rows = std::max<size_t>(1, kMinWorkPerChunk / (hess ? p * p : p));
+    const size_t chunks = parallel_chunks(X.rows(), min_rows);
+
+    std::vector<std::vector<double>> g(chunks, std::vector<double>(p, 0.0));
+    std::vector<std::vector<double>> h(hess ? chunks : 0, std::vector<double>(p * p, 0.0));
+    std::vector<double> loss(chunks, 0.0);
+
+    parallel_for(X.rows(), min_rows, [&](size_t c, size_t begin, size_t end) {
+
+        double* gc = g[c].data();
+        double chunk_loss = 0.0;
+        for (size_t r = begin; r < end; ++r) {
+
+            const real* x = X.row_ptr(r);
+            const double y = X.label(r);
+
+            const double z = w[m] + simd::dot(x, wr.data(), m);
+            const double pr = 1.0 / (1.0 + std::exp(-z));
+            const double err = pr - y;
+            chunk_loss += log_loss(z, y);
+
+            simd::multiply_accumulate(err, x, gc, m);
+            gc[m] += err;
+
+            if (hess) {
+                const double s = pr * (1.0 - pr);
+                double* hc = h[c].data();
+                for (size_t j = 0; j < m; ++j) {
+                    const double a = s * x[j];
+                    if (a == 0.0) continue;
+                    double* row = hc + j * p;
+                    simd::multiply_accumulate(a, x + j, row + j, m - j);
+                    row[m] += a;
+                }
+                hc[m * p + m] += s;
+            }
+        }
+        loss[c] = chunk_loss;
+    });
+
+    double total = 0.0;
+    for (size_t c = 0; c < chunks; ++c) {
+        for (size_t j = 0; j < p; ++j) grad[j] += g[c][j];
+        if (hess) {
+            for (size_t j = 0; j < p * p; ++j) (*hess)[j] += h[c][j];
+        }
+        total += loss[c];
+    }
+    return total;
+}
+
+// Turns summed loss / gradient / Hessian over n rows into means
+double mean_objective(double loss, size_t n, std::vector<double>& grad, std::vector<double>* hess) {
+
+    if (n == 0) return 0.0;
+    for (double& v : grad) v /= n;
+    if (hess) {
+        for (double& v : *hess) v /= n;
+    }
+    return loss / n;
+}
+
+} // namespace
+
 // --- Private Helper ---
 double LogisticRegression::sigmoid(double z) const {
     return 1.0 / (1.0 + std::exp(-z));
 }
 
-// --- Constructor ---
-LogisticRegression::LogisticRegression(double learning_rate, int max_iters)
-    : weights_(), bias_(0.0), learning_rate_(learning_rate), max_iters_(max_iters), num_features_(0) {}
+// --- Constructors ---
+LogisticRegression::LogisticRegression(double learning_rate, int max_iters, size_t batch_size)
+    : weights_(), bias_(0.0), learning_rate_(learning_rate), max_iters_(max_iters),
+      batch_size_(batch_size), num_features_(0) {}
+
+LogisticRegression::LogisticRegression(Solver solver, int max_iters, double tolerance)
+    : weights_(), bias_(0.0), learning_rate_(0.1), max_iters_(max_iters),
+      batch_size_(0), num_features_(0), solver_(solver), tolerance_(tolerance) {}
+
+// --- Weights initialization ---
+void LogisticRegression::init_weights(size_t num_features) {
+
+    num_features_ = num_features;
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::normal_distribution<> d(0.0, 0.01);
+
+    weights_.resize(num_features_);
+    for (size_t i = 0; i < num_features_; ++i) weights_[i] = d(gen);
+    bias_ = d(gen);
+
+    online_z_.clear();
+    online_n_.clear();
+}
+
+bool LogisticRegression::should_log(int epoch) const {
+    return epoch % std::max(1, max_iters_ / 10) == 0 || epoch == max_iters_ - 1;
+}
+
+// --- Gradient helpers ---
+double LogisticRegression::accumulate_gradient(const real* x, double y_true,
+                                               std::vector<double>& dw, double& db) const {
+
+    real z = bias_ + simd::dot(x, weights_.data(), num_features_);
+
+    double y_pred = sigmoid(z);
+    double error = y_pred - y_true;
+
+    simd::multiply_accumulate(error, x, dw.data(), num_features_);
+    db += error;
+
+    return -(y_true * std::log(y_pred) + (1.0 - y_true) * std::log(1.0 - y_pred));
+}
+
+double LogisticRegression::accumulate_gradient(const SparseRow& x, double y_true,
+                                               std::vector<double>& dw, double& db) const {
+
+    real z = bias_;
+    for (size_t k = 0; k < x.nnz; ++k) z += x.values[k] * weights_[x.indices[k]];
+
+    double y_pred = sigmoid(z);
+    double error = y_pred - y_true;
+
+    for (size_t k = 0; k < x.nnz; ++k) dw[x.indices[k]] += error * x.values[k];
+    db += error;
+
+    return -(y_true * std::log(y_pred) + (1.0 - y_true) * std::log(1.0 - y_pred));
+}
+
+double LogisticRegression::batch_gradient(const Dataset& rows, const size_t* order, size_t count,
+                                          std::vector<double>& dw, double& db) {
+
+    // Large batches are cut by work per chunk; a mini-batch of a few hundred rows is
+    // still spread over the whole pool, down to kMinBatchRows rows per chunk
+    const size_t threads = ThreadPool::instance().size();
+    const size_t by_work = std::max<size_t>(1, kMinWorkPerChunk / std::max<size_t>(num_features_, 1));
+    const size_t min_rows = std::min(by_work, std::max(kMinBatchRows, (count + threads - 1) / threads));
+    const size_t chunks = parallel_chunks(count, min_rows);
+
+    // Chunk 0 accumulates straight into dw; the others get their own buffer
+    if (partial_dw_.size() + 1 < chunks) partial_dw_.resize(chunks - 1);
+    std::vector<double> partial_db(chunks, 0.0), partial_loss(chunks, 0.0);
+
+    parallel_for(count, min_rows, [&](size_t c, size_t begin, size_t end) {
+
+        std::vector<double>& g = (c == 0) ? dw : partial_dw_[c - 1];
+        g.assign(num_features_, 0.0);
+
+        double chunk_db = 0.0, chunk_loss = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            size_t r = order ? order[i] : i;
+            chunk_loss += accumulate_gradient(rows.row_ptr(r), rows.label(r), g, chunk_db);
+        }
+        partial_db[c] = chunk_db;
+        partial_loss[c] = chunk_loss;
+    });
+
+    double loss = 0.0;
+    db = 0.0;
+    for (size_t c = 0; c < chunks; ++c) {
+        if (c > 0) {
+            const std::vector<double>& g = partial_dw_[c - 1];
+            for (size_t i = 0; i < num_features_; ++i) dw[i] += g[i];
+        }
+        db += partial_db[c];
+        loss += partial_loss[c];
+    }
+    return loss;
+}
+
+void LogisticRegression::apply_gradient(const std::vector<double>& dw, double db, size_t n,
+                                        const std::vector<SparseMatrix::index_type>* columns) {
+
+    if (columns) {
+        for (SparseMatrix::index_type i : *columns) weights_[i] -= learning_rate_ * (dw[i] / n);
+    } else {
+        for (size_t i = 0; i < num_features_; ++i) weights_[i] -= learning_rate_ * (dw[i] / n);
+    }
+    bias_ -= learning_rate_ * (db / n);
+}
+
+void LogisticRegression::log_epoch(int epoch, double avg_loss) const {
+
+    if (should_log(epoch)) {
+        std::cout << "Epoch " << std::setw(4) << std::left << epoch 
+                  << " | Loss: " << std::fixed << std::setprecision(5) << avg_loss
+                  << " | Bias: " << std::setprecision(3) << bias_ << std::endl;
+    }
+}
 
 // --- Train method ---
 void LogisticRegression::train(std::vector<DataPoint>& data) {
@@ -26,76 +281,552 @@ void LogisticRegression::train(std::vector<DataPoint>& data) {
         return;
     }
 
-    num_features_ = data[0].features.size() - 1;
-    if (num_features_ <= 0) {
+    if (data[0].features.size() < 2) {
         throw std::runtime_error("Dataset must have at least one feature and one target.");
     }
 
-    // Weights initialization
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<> d(0.0, 0.01);
+    // The last feature of every DataPoint is the target
+    const size_t m = data[0].features.size() - 1;
+    Dataset ds(data.size(), m);
+    real* labels = ds.mutable_labels();
 
-    weights_.resize(num_features_);
-    for (size_t i = 0; i < num_features_; ++i) weights_[i] = d(gen);
-    bias_ = d(gen);
+    for (size_t r = 0; r < data.size(); ++r) {
+        if (data[r].features.size() != m + 1) throw std::runtime_error("Feature size mismatch.");
+        std::copy(data[r].features.begin(), data[r].features.end() - 1, ds.row_ptr(r));
+        labels[r] = data[r].features.back();
+    }
+
+    train(ds);
+}
+
+void LogisticRegression::train(const Dataset& data) {
+
+    if (data.empty()) {
+        std::cerr << "Warning: Cannot train on empty dataset." << std::endl;
+        return;
+    }
+    if (!data.has_labels() || data.cols() == 0) {
+        throw std::runtime_error("Dataset must have at least one feature and one target.");
+    }
+
+    const Dataset rows = data.as_row_major();
+    const size_t n = rows.rows();
+
+    if (solver_ != Solver::GradientDescent) {
+        num_features_ = rows.cols();
+        minimize([&](const std::vector<double>& w, std::vector<double>& grad, std::vector<double>* hess) {
+            grad.assign(w.size(), 0.0);
+            if (hess) hess->assign(w.size() * w.size(), 0.0);
+            return mean_objective(add_dense_objective(rows, w, grad, hess), n, grad, hess);
+        });
+        return;
+    }
+
+    init_weights(rows.cols());
+
+    const bool mini_batch = batch_size_ > 0 && batch_size_ < n;
 
     std::cout << "Starting Logistic Regression training (" 
+              << num_features_ << " features, " << max_iters_ << " epochs";
+    if (mini_batch) std::cout << ", batch size " << batch_size_;
+    std::cout << ")..." << std::endl;
+
+    std::vector<double> dw(num_features_);
+
+    std::vector<size_t> order;
+    std::mt19937 rng(kShuffleSeed);
+    if (mini_batch) {
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+    }
+
+    for (int epoch = 0; epoch < max_iters_; ++epoch) {
+
+        double total_loss = 0.0;
+
+        if (mini_batch) {
+            std::shuffle(order.begin(), order.end(), rng);
+
+            for (size_t begin = 0; begin < n; begin += batch_size_) {
+                size_t count = std::min(batch_size_, n - begin);
+                double db;
+                total_loss += batch_gradient(rows, order.data() + begin, count, dw, db);
+                apply_gradient(dw, db, count);
+            }
+        } else {
+            double db;
+            total_loss = batch_gradient(rows, nullptr, n, dw, db);
+            apply_gradient(dw, db, n);
+        }
+
+        log_epoch(epoch, total_loss / n);
+    }
+
+    std::cout << "Logistic Regression training finished." << std::endl;
+}
+
+void LogisticRegression::train(DatasetStream& stream) {
+
+    if (!stream.has_labels() || stream.cols() == 0) {
+        throw std::runtime_error("Stream must provide at least one feature and a label column.");
+    }
+
+    // Every objective evaluation is one pass over the stream
+    if (solver_ != Solver::GradientDescent) {
+        num_features_ = stream.cols();
+        Dataset batch;
+        minimize([&](const std::vector<double>& w, std::vector<double>& grad, std::vector<double>* hess) {
+            grad.assign(w.size(), 0.0);
+            if (hess) hess->assign(w.size() * w.size(), 0.0);
+
+            double loss = 0.0;
+            size_t n = 0;
+            stream.rewind();
+            while (stream.next_batch(batch)) {
+                loss += add_dense_objective(batch, w, grad, hess);
+                n += batch.rows();
+            }
+            return mean_objective(loss, n, grad, hess);
+        });
+        return;
+    }
+
+    init_weights(stream.cols());
+
+    std::cout << "Starting streamed Logistic Regression training (" 
               << num_features_ << " features, " << max_iters_ << " epochs)..." << std::endl;
 
+    Dataset batch;
+    std::vector<double> dw(num_features_, 0.0), batch_dw;
+
+    for (int epoch = 0; epoch < max_iters_; ++epoch) {
+
+        std::fill(dw.begin(), dw.end(), 0.0);
+        double db = 0.0;
+        double total_loss = 0.0;
+        size_t n = 0;
+
+        stream.rewind();
+        while (stream.next_batch(batch)) {
+            double batch_db;
+            total_loss += batch_gradient(batch, nullptr, batch.rows(), batch_dw, batch_db);
+            for (size_t i = 0; i < num_features_; ++i) dw[i] += batch_dw[i];
+            db += batch_db;
+            n += batch.rows();
+        }
+
+        if (n == 0) {
+            std::cerr << "Warning: Cannot train on empty dataset." << std::endl;
+            return;
+        }
+        apply_gradient(dw, db, n);
+        log_epoch(epoch, total_loss / n);
+    }
+
+    std::cout << "Logistic Regression training finished." << std::endl;
+}
+
+void LogisticRegression::train(const SparseMatrix& data) {
+
+    if (data.empty()) {
+        std::cerr << "Warning: Cannot train on empty dataset." << std::endl;
+        return;
+    }
+    if (!data.has_labels() || data.cols() == 0) {
+        throw std::runtime_error("Dataset must have at least one feature and one target.");
+    }
+
+    if (solver_ == Solver::Newton) {
+        throw std::runtime_error("Newton solver needs a dense Hessian; use Solver::LBFGS for sparse data.");
+    }
+    if (solver_ == Solver::LBFGS) {
+        num_features_ = data.cols();
+        const size_t m = num_features_;
+        minimize([&](const std::vector<double>& w, std::vector<double>& grad, std::vector<double>* hess) {
+            grad.assign(w.size(), 0.0);
+
+            double loss = 0.0;
+            for (size_t r = 0; r < data.rows(); ++r) {
+                SparseRow x = data.row(r);
+                double y = data.label(r) > 0 ? 1.0 : 0.0;
+
+                double z = w[m];
+                for (size_t k = 0; k < x.nnz; ++k) z += w[x.indices[k]] * x.values[k];
+
+                double err = sigmoid(z) - y;
+                loss += log_loss(z, y);
+                for (size_t k = 0; k < x.nnz; ++k) grad[x.indices[k]] += err * x.values[k];
+                grad[m] += err;
+            }
+            return mean_objective(loss, data.rows(), grad, hess);
+        });
+        return;
+    }
+
+    init_weights(data.cols());
+
+    // Columns without a nonzero never receive gradient, so they are skipped entirely
+    const std::vector<SparseMatrix::index_type> active = data.active_columns();
+
+    std::cout << "Starting sparse Logistic Regression training (" 
+              << num_features_ << " features, " << data.nnz() << " nonzeros, "
+              << max_iters_ << " epochs)..." << std::endl;
+
+    std::vector<double> dw(num_features_);
+
     for (int epoch = 0; epoch < max_iters_; ++epoch) {
 
-        std::vector<double> dw(num_features_, 0.0);
+        for (SparseMatrix::index_type i : active) dw[i] = 0.0;
         double db = 0.0;
         double total_loss = 0.0;
 
-        for (auto& point : data) {
+        for (size_t r = 0; r < data.rows(); ++r) {
+            double y = data.label(r) > 0 ? 1.0 : 0.0;
+            total_loss += accumulate_gradient(data.row(r), y, dw, db);
+        }
+
+        apply_gradient(dw, db, data.rows(), &active);
+        log_epoch(epoch, total_loss / data.rows());
+    }
+
+    std::cout << "Logistic Regression training finished." << std::endl;
+}
 
-            double y_true = point.features.back();
-            double z = bias_;
+// --- Second-order / quasi-Newton solvers ---
+void LogisticRegression::set_parameters(const std::vector<double>& w) {
+    weights_.assign(w.begin(), w.end() - 1);
+    bias_ = static_cast<real>(w.back());
+    online_z_.clear();
+    online_n_.clear();
+}
 
-            for (size_t i = 0; i < num_features_; ++i) z += point.features[i] * weights_[i];
+void LogisticRegression::minimize(const Objective& f) {
 
-            double y_pred = sigmoid(z);
-            double error = y_pred - y_true;
+    std::cout << "Starting " << (solver_ == Solver::Newton ? "Newton (IRLS)" : "L-BFGS")
+              << " Logistic Regression training (" << num_features_ << " features, tolerance "
+              << std::defaultfloat << tolerance_ << ")..." << std::endl;
 
-            for (size_t i = 0; i < num_features_; ++i) dw[i] += error * point.features[i];
-            db += error;
+    if (solver_ == Solver::Newton) minimize_newton(f);
+    else minimize_lbfgs(f);
 
-            total_loss += -(y_true * std::log(y_pred) + (1.0 - y_true) * std::log(1.0 - y_pred));
+    std::cout << "Logistic Regression training finished." << std::endl;
+}
+
+void LogisticRegression::minimize_newton(const Objective& f) {
+
+    const size_t p = num_features_ + 1;
+    std::vector<double> w(p, 0.0), g, h, w_new(p), g_new, h_new, a(p * p), d;
+
+    double loss = f(w, g, &h);
+
+    for (int it = 0; it < max_iters_; ++it) {
+
+        check_finite(loss, g);
+        set_parameters(w);
+        log_epoch(it, loss);
+
+        if (max_abs(g) <= tolerance_) {
+            std::cout << "Converged after " << it << " iterations." << std::endl;
+            return;
         }
 
-        for (size_t i = 0; i < num_features_; ++i) dw[i] /= data.size();
+        // Solve H d = g; separable data makes H near-singular, so damp until it factors
+        double max_diag = 0.0;
+        for (size_t j = 0; j < p; ++j) max_diag = std::max(max_diag, h[j * p + j]);
 
-        db /= data.size();
-        double avg_loss = total_loss / data.size();
+        double damping = 0.0;
+        for (int attempt = 0; ; ++attempt) {
+            for (size_t j = 0; j < p; ++j) {
+                for (size_t k = j; k < p; ++k) a[j * p + k] = a[k * p + j] = h[j * p + k];
+                a[j * p + j] += damping;
+            }
+            if (cholesky_factor(a, p)) break;
+
+            damping = (damping == 0.0) ? 1e-10 * (max_diag > 0.0 ? max_diag : 1.0) : damping * 10;
+            if (attempt == kMaxDamping || !std::isfinite(damping)) {
+                throw std::runtime_error("Newton step failed: the Hessian could not be factored even with damping.");
+            }
+        }
 
-        for (size_t i = 0; i < num_features_; ++i) weights_[i] -= learning_rate_ * dw[i];
-        bias_ -= learning_rate_ * db;
+        d = g;
+        cholesky_solve(a, p, d);
 
-        if (epoch % (max_iters_ / 10) == 0 || epoch == max_iters_ - 1) {
-            std::cout << "Epoch " << std::setw(4) << std::left << epoch 
-                      << " | Loss: " << std::fixed << std::setprecision(5) << avg_loss
-                      << " | Bias: " << std::setprecision(3) << bias_ << std::endl;
+        // Backtracking line search along -d
+        const double slope = dot(g, d);
+        double step = 1.0, loss_new = loss;
+        bool accepted = false;
+
+        for (int ls = 0; ls < kMaxLineSearch && !accepted; ++ls, step *= 0.5) {
+            for (size_t j = 0; j < p; ++j) w_new[j] = w[j] - step * d[j];
+            loss_new = f(w_new, g_new, &h_new);
+            accepted = loss_new <= loss - kArmijo * step * slope;
+        }
+
+        if (!accepted) {
+            std::cout << "Line search made no progress; stopping after " << it << " iterations." << std::endl;
+            break;
         }
+
+        std::swap(w, w_new);
+        std::swap(g, g_new);
+        std::swap(h, h_new);
+        loss = loss_new;
     }
 
-    std::cout << "Logistic Regression training finished." << std::endl;
+    set_parameters(w);
+}
+
+void LogisticRegression::minimize_lbfgs(const Objective& f) {
+
+    const size_t p = num_features_ + 1;
+    std::vector<double> w(p, 0.0), g, w_new(p), g_new, d(p);
+
+    // Most recent curvature pairs s = Δw, y = Δg, oldest first
+    std::vector<std::vector<double>> S, Y;
+    std::vector<double> rho, alpha(kLbfgsHistory);
+
+    double loss = f(w, g, nullptr);
+
+    for (int it = 0; it < max_iters_; ++it) {
+
+        check_finite(loss, g);
+        set_parameters(w);
+        log_epoch(it, loss);
+
+        if (max_abs(g) <= tolerance_) {
+            std::cout << "Converged after " << it << " iterations." << std::endl;
+            return;
+        }
+
+        // Two-loop recursion: d ≈ H⁻¹ g
+        d = g;
+        for (size_t i = S.size(); i-- > 0; ) {
+            alpha[i] = rho[i] * dot(S[i], d);
+            for (size_t j = 0; j < p; ++j) d[j] -= alpha[i] * Y[i][j];
+        }
+
+        double gamma = S.empty() ? 1.0 / std::sqrt(dot(g, g))
+                                 : dot(S.back(), Y.back()) / dot(Y.back(), Y.back());
+        for (double& v : d) v *= gamma;
+
+        for (size_t i = 0; i < S.size(); ++i) {
+            double beta = rho[i] * dot(Y[i], d);
+            for (size_t j = 0; j < p; ++j) d[j] += S[i][j] * (alpha[i] - beta);
+        }
+
+        double slope = dot(g, d);
+        if (!(slope > 0.0)) {
+            // Not a descent direction: forget the history and use the scaled gradient
+            S.clear();
+            Y.clear();
+            rho.clear();
+            double inv_norm = 1.0 / std::sqrt(dot(g, g));
+            for (size_t j = 0; j < p; ++j) d[j] = g[j] * inv_norm;
+            slope = dot(g, d);
+        }
+
+        double step = 1.0, loss_new = loss;
+        bool accepted = false;
+
+        for (int ls = 0; ls < kMaxLineSearch && !accepted; ++ls, step *= 0.5) {
+            for (size_t j = 0; j < p; ++j) w_new[j] = w[j] - step * d[j];
+            loss_new = f(w_new, g_new, nullptr);
+            accepted = loss_new <= loss - kArmijo * step * slope;
+        }
+
+        if (!accepted) {
+            std::cout << "Line search made no progress; stopping after " << it << " iterations." << std::endl;
+            break;
+        }
+
+        std::vector<double> s(p), y(p);
+        for (size_t j = 0; j < p; ++j) {
+            s[j] = w_new[j] - w[j];
+            y[j] = g_new[j] - g[j];
+        }
+
+        // Keep only pairs with positive curvature so the implicit Hessian stays positive definite
+        double sy = dot(s, y);
+        if (sy > 1e-12 * dot(y, y)) {
+            if (S.size() == kLbfgsHistory) {
+                S.erase(S.begin());
+                Y.erase(Y.begin());
+                rho.erase(rho.begin());
+            }
+            S.push_back(std::move(s));
+            Y.push_back(std::move(y));
+            rho.push_back(1.0 / sy);
+        }
+
+        std::swap(w, w_new);
+        std::swap(g, g_new);
+        loss = loss_new;
+    }
+
+    set_parameters(w);
+}
+
+// --- Online learning ---
+void LogisticRegression::set_online_regularization(double l1, double l2) {
+    if (l1 < 0.0 || l2 < 0.0) throw std::runtime_error("Regularization strengths must be non-negative.");
+    online_l1_ = l1;
+    online_l2_ = l2;
+}
+
+void LogisticRegression::prepare_online(size_t cols, bool allow_growth) {
+
+    if (online_z_.empty()) {
+
+        if (weights_.empty()) {
+            num_features_ = cols;
+            weights_.assign(cols, 0.0);
+            bias_ = 0.0;
+        }
+
+        // Invert ftrl_weight at n = 0 so the first update continues from the current model
+        const double scale = kFtrlBeta / learning_rate_;
+        online_z_.assign(num_features_ + 1, 0.0);
+        online_n_.assign(num_features_ + 1, 0.0);
+        for (size_t i = 0; i < num_features_; ++i) {
+            const double w = weights_[i];
+            if (w != 0.0) online_z_[i] = -w * (scale + online_l2_) - std::copysign(online_l1_, w);
+        }
+        online_z_[num_features_] = -bias_ * scale;
+    }
+
+    if (allow_growth && cols > num_features_) {
+        const size_t extra = cols - num_features_;
+        weights_.resize(cols, 0.0);
+        online_z_.insert(online_z_.end() - 1, extra, 0.0);
+        online_n_.insert(online_n_.end() - 1, extra, 0.0);
+        num_features_ = cols;
+    }
+
+    if (!allow_growth && cols != num_features_) throw std::runtime_error("Feature size mismatch.");
+}
+
+double LogisticRegression::ftrl_update(size_t i, double g, double current) {
+
+    const bool is_bias = i == num_features_;
+    double& z = online_z_[i];
+    double& n = online_n_[i];
+
+    const double sigma = (std::sqrt(n + g * g) - std::sqrt(n)) / learning_rate_;
+    z += g - sigma * current;
+    n += g * g;
+
+    return ftrl_weight(z, n, learning_rate_, is_bias ? 0.0 : online_l1_, is_bias ? 0.0 : online_l2_);
+}
+
+double LogisticRegression::partial_fit(const Dataset& batch) {
+
+    if (batch.empty()) return 0.0;
+    if (!batch.has_labels() || batch.cols() == 0) {
+        throw std::runtime_error("Dataset must have at least one feature and one target.");
+    }
+
+    prepare_online(batch.cols(), false);
+
+    const Dataset rows = batch.as_row_major();
+    double loss = 0.0;
+
+    for (size_t r = 0; r < rows.rows(); ++r) {
+
+        const real* x = rows.row_ptr(r);
+        const double y = rows.label(r);
+        const double z = bias_ + simd::dot(x, weights_.data(), num_features_);
+        loss += log_loss(z, y);
+
+        const double g = sigmoid(z) - y;
+        for (size_t j = 0; j < num_features_; ++j) {
+            if (x[j] != 0) weights_[j] = static_cast<real>(ftrl_update(j, g * x[j], weights_[j]));
+        }
+        bias_ = static_cast<real>(ftrl_update(num_features_, g, bias_));
+    }
+    return loss / rows.rows();
+}
+
+double LogisticRegression::partial_fit(const SparseMatrix& batch) {
+
+    if (batch.empty()) return 0.0;
+    if (!batch.has_labels()) throw std::runtime_error("Sparse dataset must have labels.");
+
+    prepare_online(batch.cols(), true);
+
+    double loss = 0.0;
+
+    for (size_t r = 0; r < batch.rows(); ++r) {
+
+        const SparseRow x = batch.row(r);
+        const double y = batch.label(r) > 0 ? 1.0 : 0.0;
+
+        double z = bias_;
+        for (size_t k = 0; k < x.nnz; ++k) z += x.values[k] * weights_[x.indices[k]];
+        loss += log_loss(z, y);
+
+        const double g = sigmoid(z) - y;
+        for (size_t k = 0; k < x.nnz; ++k) {
+            const size_t j = x.indices[k];
+            weights_[j] = static_cast<real>(ftrl_update(j, g * x.values[k], weights_[j]));
+        }
+        bias_ = static_cast<real>(ftrl_update(num_features_, g, bias_));
+    }
+    return loss / batch.rows();
 }
 
 // --- Predict probability ---
-double LogisticRegression::predict_proba(const std::vector<double>& features) const {
+double LogisticRegression::predict_proba(const std::vector<real>& features) const {
     
     if (features.size() != num_features_) throw std::runtime_error("Feature size mismatch.");
 
-    double z = bias_;
-    for (size_t i = 0; i < num_features_; ++i) z += features[i] * weights_[i];
+    real z = bias_ + simd::dot(features.data(), weights_.data(), num_features_);
+    return sigmoid(z);
+}
+
+double LogisticRegression::predict_proba(const SparseRow& features) const {
+
+    real z = bias_;
+    for (size_t k = 0; k < features.nnz; ++k) {
+        if (features.indices[k] >= num_features_) throw std::runtime_error("Feature index out of range.");
+        z += features.values[k] * weights_[features.indices[k]];
+    }
     return sigmoid(z);
 }
 
 // --- Predict class ---
-int LogisticRegression::predict(const std::vector<double>& features) const {
+int LogisticRegression::predict(const std::vector<real>& features) const {
+    return (predict_proba(features) >= 0.5) ? 1 : 0;
+}
+
+int LogisticRegression::predict(const SparseRow& features) const {
     return (predict_proba(features) >= 0.5) ? 1 : 0;
 }
 
+// --- Batch prediction ---
+void LogisticRegression::predict_proba_batch(const Dataset& X, double* out) const {
+
+    if (X.cols() != num_features_) throw std::runtime_error("Feature size mismatch.");
+
+    score_rows(X.data(), X.rows(), X.cols(), X.leading_dim(), X.layout(), weights_.data(), bias_, out,
+               [this](real z) { return sigmoid(z); });
+}
+
+void LogisticRegression::predict_batch(const Dataset& X, int* out) const {
+
+    if (X.cols() != num_features_) throw std::runtime_error("Feature size mismatch.");
+
+    score_rows(X.data(), X.rows(), X.cols(), X.leading_dim(), X.layout(), weights_.data(), bias_, out,
+               [this](real z) { return (sigmoid(z) >= 0.5) ? 1 : 0; });
+}
+
+void LogisticRegression::predict_proba_batch(const real* X, size_t rows, double* out) const {
+    score_rows(X, rows, num_features_, num_features_, Layout::RowMajor, weights_.data(), bias_, out,
+               [this](real z) { return sigmoid(z); });
+}
+
+void LogisticRegression::predict_batch(const real* X, size_t rows, int* out) const {
+    score_rows(X, rows, num_features_, num_features_, Layout::RowMajor, weights_.data(), bias_, out,
+               [this](real z) { return (sigmoid(z) >= 0.5) ? 1 : 0; });
+}
+
 } // namespace aicpp
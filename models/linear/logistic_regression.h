@@ -1,29 +1,131 @@
 #pragma once
 #include <vector>
 #include <cstddef> // for size_t
+#include <functional>
 #include "../../core/data_types.h"
+#include "../../core/dataset.h"
+#include "../../core/sparse_matrix.h"
 
+class DatasetStream;
 
 namespace aicpp {
 
 class LogisticRegression {
 public:
-    LogisticRegression(double learning_rate, int max_iters);
+    // GradientDescent: fixed learning rate, max_iters epochs (optionally mini-batch).
+    // Newton: IRLS with exact Hessian and backtracking; O(N·F²) per iteration, for moderate F.
+    // LBFGS: limited-memory quasi-Newton with backtracking; O(N·F) per iteration, for wide models.
+    enum class Solver { GradientDescent, Newton, LBFGS };
 
+    // batch_size = 0 trains with full-batch gradient descent; otherwise every epoch
+    // shuffles the rows and takes one step per mini-batch of batch_size rows
+    LogisticRegression(double learning_rate, int max_iters, size_t batch_size = 0);
+
+    // Newton and LBFGS start from zero weights and stop once every component of the
+    // mean gradient is within tolerance, or after max_iters iterations
+    LogisticRegression(Solver solver, int max_iters, double tolerance = 1e-6);
+
+    // The last feature of each DataPoint is used as the 0/1 target
     void train(std::vector<DataPoint>& data);
 
-    double predict_proba(const std::vector<double>& features) const;
-    int predict(const std::vector<double>& features) const;
+    // Features from the dataset, targets from its label array.
+    // Each batch's gradient is accumulated across the shared thread pool.
+    void train(const Dataset& data);
+
+    // Out-of-core training: full-batch gradient descent where each epoch is one
+    // pass over the stream, so memory is bounded by the stream's batch size
+    void train(DatasetStream& stream);
+
+    // Sparse training (GradientDescent or LBFGS): per-epoch cost is O(nnz + active columns) instead of O(rows * cols).
+    // Any positive label is class 1, so libsvm-style -1/+1 targets work as-is.
+    void train(const SparseMatrix& data);
+
+    // Online learning: updates the current model from one batch with FTRL-Proximal
+    // (per-feature AdaGrad step sizes scaled by the learning rate) instead of
+    // retraining. The optimizer state is kept between calls and starts from the
+    // weights of a previous train(), or from zero on a fresh model; train() resets it.
+    // Sparse batches may introduce new feature indices, which start at zero weight.
+    // Returns the batch's mean log-loss, each row scored before its own update.
+    double partial_fit(const Dataset& batch);
+    double partial_fit(const SparseMatrix& batch);
+
+    // L1 / L2 strengths used by partial_fit (default 0); L1 keeps rarely useful
+    // weights at exactly zero. The bias is not penalised.
+    void set_online_regularization(double l1, double l2);
+
+    double predict_proba(const std::vector<real>& features) const;
+    int predict(const std::vector<real>& features) const;
+
+    // Sparse prediction in O(nnz); indices must be below the trained feature count
+    double predict_proba(const SparseRow& features) const;
+    int predict(const SparseRow& features) const;
+
+    // Batch prediction into caller-provided buffers of X.rows() entries. Rows are
+    // scored with a blocked SIMD matrix-vector product split across the thread pool;
+    // either layout works and nothing is allocated per row.
+    void predict_proba_batch(const Dataset& X, double* out) const;
+    void predict_batch(const Dataset& X, int* out) const;
+
+    // Same, for `rows` contiguous row-major rows of the trained feature count
+    void predict_proba_batch(const real* X, size_t rows, double* out) const;
+    void predict_batch(const real* X, size_t rows, int* out) const;
 
 private:
     double sigmoid(double z) const;
+    void init_weights(size_t num_features);
+    bool should_log(int epoch) const;
 
-    std::vector<double> weights_;
-    double bias_;
+    // Adds one sample's gradient to dw/db and returns its log-loss
+    double accumulate_gradient(const real* x, double y_true,
+                               std::vector<double>& dw, double& db) const;
+    double accumulate_gradient(const SparseRow& x, double y_true,
+                               std::vector<double>& dw, double& db) const;
+
+    // Gradient and summed log-loss of rows order[0..count) (rows [0, count) if order is null),
+    // accumulated in parallel into per-chunk buffers and reduced into dw/db
+    double batch_gradient(const Dataset& rows, const size_t* order, size_t count,
+                          std::vector<double>& dw, double& db);
+
+    // Gradient step over every feature, or only over `columns` when given
+    void apply_gradient(const std::vector<double>& dw, double db, size_t n,
+                        const std::vector<SparseMatrix::index_type>* columns = nullptr);
+    void log_epoch(int epoch, double avg_loss) const;
+
+    // Mean log-loss at w (weights, then bias); fills the mean gradient and, when
+    // hessian is non-null, the mean Hessian (row-major, upper triangle)
+    using Objective = std::function<double(const std::vector<double>& w, std::vector<double>& grad,
+                                           std::vector<double>* hessian)>;
+
+    void minimize(const Objective& f);
+    void minimize_newton(const Objective& f);
+    void minimize_lbfgs(const Objective& f);
+    void set_parameters(const std::vector<double>& w);
+
+    // Builds the FTRL state on first use (from the current weights) and grows it
+    // to `cols` features when allowed; throws on a dense feature count mismatch
+    void prepare_online(size_t cols, bool allow_growth);
+
+    // Applies gradient g to coordinate i (num_features_ is the bias) and returns its new value
+    double ftrl_update(size_t i, double g, double current);
+
+    std::vector<real> weights_;
+    real bias_;
     double learning_rate_;
     
     int max_iters_;
+    size_t batch_size_;
     size_t num_features_; 
+
+    Solver solver_ = Solver::GradientDescent;
+    double tolerance_ = 0.0;
+
+    std::vector<std::vector<double>> partial_dw_;  // per-chunk gradients, reused across batches
+
+    // FTRL-Proximal state (z and summed squared gradients n), bias last; empty until partial_fit
+    std::vector<double> online_z_;
+    std::vector<double> online_n_;
+    double online_l1_ = 0.0;
+    double online_l2_ = 0.0;
 };
 
 } // namespace aicpp 
@@ -1,22 +1,183 @@
 #include "multi_linear_regression.h"
+#include "../../core/linalg.h"
+#include "../../core/linear_batch.h"
+#include "../../core/simd.h"
+#include "../../core/thread_pool.h"
+#include "../../data/preprocessing/dataset_stream.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
 
 
-MultiLinearRegression::MultiLinearRegression(double learning_rate)
-    : learning_rate_(learning_rate), bias_(0.0) {}
+namespace {
 
-double MultiLinearRegression::predict(const std::vector<double>& features) const {
+// Rows folded into the Gram matrix together, so each Gram row is reused while cached
+const size_t kRowBlock = 8;
 
-    double r = bias_;
-    for (size_t i = 0; i < weights_.size(); i++)
-        r += weights_[i] * features[i];
-    return r;
+// Minimum multiply-adds per parallel chunk
+const size_t kMinWorkPerChunk = 1 << 16;
+
+// Above this estimate of cond(XᵀX) the normal equations lose too many digits
+const double kMaxNormalCondition = 1e10;
+
+// Sufficient statistics of the augmented design [X 1]: upper triangle of its Gram
+// matrix, [X 1]ᵀy and yᵀy
+struct NormalEquations {
+
+    size_t p = 0;
+    size_t n = 0;
+    std::vector<double> gram;
+    std::vector<double> xty;
+    double yty = 0.0;
+    std::vector<aicpp::real> block;  // kRowBlock augmented rows
+
+    explicit NormalEquations(size_t dim = 0)
+        : p(dim), gram(dim * dim, 0.0), xty(dim, 0.0), block(kRowBlock * dim) {}
+
+    void add_rows(const aicpp::Dataset& X, size_t begin, size_t end) {
+
+        const size_t m = p - 1;
+        for (size_t b0 = begin; b0 < end; b0 += kRowBlock) {
+
+            const size_t nb = std::min(kRowBlock, end - b0);
+            for (size_t r = 0; r < nb; ++r) {
+                const aicpp::real* x = X.row_ptr(b0 + r);
+                aicpp::real* d = block.data() + r * p;
+                std::copy(x, x + m, d);
+                d[m] = 1;
+
+                double y = X.label(b0 + r);
+                aicpp::simd::multiply_accumulate(y, d, xty.data(), p);
+                yty += y * y;
+            }
+
+            // Rank-nb update of the upper triangle
+            for (size_t j = 0; j < p; ++j) {
+                double* g = gram.data() + j * p;
+                for (size_t r = 0; r < nb; ++r) {
+                    const aicpp::real* d = block.data() + r * p;
+                    const double a = d[j];
+                    if (a == 0.0) continue;
+                    aicpp::simd::multiply_accumulate(a, d + j, g + j, p - j);
+                }
+            }
+        }
+        n += end - begin;
+    }
+
+    void merge(const NormalEquations& o) {
+        for (size_t i = 0; i < gram.size(); ++i) gram[i] += o.gram[i];
+        for (size_t i = 0; i < p; ++i) xty[i] += o.xty[i];
+        yty += o.yty;
+        n += o.n;
+    }
+
+    // Mean squared error of the augmented solution w, from the statistics alone
+    double mse(const std::vector<double>& w) const {
+        double quad = 0.0, lin = 0.0;
+        for (size_t j = 0; j < p; ++j) {
+            lin += w[j] * xty[j];
+            for (size_t k = 0; k < p; ++k) {
+                double g = (j <= k) ? gram[j * p + k] : gram[k * p + j];
+                quad += w[j] * g * w[k];
+            }
+        }
+        return n ? std::max(0.0, yty - 2.0 * lin + quad) / n : 0.0;
+    }
+};
+
+// Adds the rows of X to per-chunk accumulators in parallel; partial[c] is reused across
+// calls, so a stream can feed every batch into the same set before the final merge
+template <typename Acc, typename AddRows>
+void accumulate_parallel(const aicpp::Dataset& X, size_t p, std::vector<Acc>& partial, AddRows add_rows) {
+
+    const size_t min_rows = std::max<size_t>(1, kMinWorkPerChunk / (p * p));
+    const size_t chunks = aicpp::parallel_chunks(X.rows(), min_rows);
+    while (partial.size() < chunks) partial.emplace_back(p);
+
+    aicpp::parallel_for(X.rows(), min_rows, [&](size_t c, size_t begin, size_t end) {
+        add_rows(partial[c], begin, end);
+    });
+}
+
+void add_qr_rows(aicpp::IncrementalQR& qr, const aicpp::Dataset& X, size_t begin, size_t end) {
+
+    const size_t m = X.cols();
+    std::vector<double> d(m + 1);
+    for (size_t r = begin; r < end; ++r) {
+        const aicpp::real* x = X.row_ptr(r);
+        std::copy(x, x + m, d.begin());
+        d[m] = 1.0;
+        qr.add_row(d.data(), X.label(r));
+    }
+}
+
+// Solves (XᵀX + ridge·I) w = Xᵀy on the augmented system; false if Cholesky fails or
+// the system is too ill-conditioned to trust
+bool solve_cholesky(const NormalEquations& ne, double ridge, std::vector<double>& w) {
+
+    const size_t p = ne.p;
+    std::vector<double> a(p * p);
+    for (size_t j = 0; j < p; ++j)
+        for (size_t k = j; k < p; ++k) a[j * p + k] = a[k * p + j] = ne.gram[j * p + k];
+    for (size_t j = 0; j + 1 < p; ++j) a[j * p + j] += ridge;
+
+    double condition;
+    if (!aicpp::cholesky_factor(a, p, &condition) || condition > kMaxNormalCondition) return false;
+
+    w = ne.xty;
+    aicpp::cholesky_solve(a, p, w);
+    return true;
+}
+
+// Ridge rows sqrt(ridge)·e_j (target 0) for every weight column
+void add_ridge_rows(aicpp::IncrementalQR& qr, double ridge) {
+
+    if (ridge <= 0.0) return;
+    std::vector<double> e(qr.size(), 0.0);
+    for (size_t j = 0; j + 1 < qr.size(); ++j) {
+        e[j] = std::sqrt(ridge);
+        qr.add_row(e.data(), 0.0);
+        e[j] = 0.0;
+    }
+}
+
+void report_direct(const char* method, double loss, double bias) {
+    std::cout << "Direct solve (" << method << ") | Loss=" << loss << " | b=" << bias << "\n";
+}
+
+} // namespace
+
+
+MultiLinearRegression::MultiLinearRegression(double learning_rate, Solver solver, double ridge)
+    : bias_(0.0), learning_rate_(learning_rate), solver_(solver), ridge_(ridge) {}
+
+double MultiLinearRegression::predict(const std::vector<aicpp::real>& features) const {
+    return predict(features.data());
+}
+
+double MultiLinearRegression::predict(const aicpp::real* features) const {
+
+    return bias_ + aicpp::simd::dot(weights_.data(), features, weights_.size());
+}
+
+void MultiLinearRegression::predict_batch(const aicpp::Dataset& X, double* out) const {
+
+    if (X.cols() != weights_.size()) throw std::runtime_error("Feature size mismatch.");
+
+    aicpp::score_rows(X.data(), X.rows(), X.cols(), X.leading_dim(), X.layout(),
+                      weights_.data(), bias_, out, [](aicpp::real z) { return double(z); });
+}
+
+void MultiLinearRegression::predict_batch(const aicpp::real* X, size_t rows, double* out) const {
+    aicpp::score_rows(X, rows, weights_.size(), weights_.size(), aicpp::Layout::RowMajor,
+                      weights_.data(), bias_, out, [](aicpp::real z) { return double(z); });
 }
 
 double MultiLinearRegression::compute_loss(
-    const std::vector<std::vector<double>>& X,
-    const std::vector<double>& y) const
+    const std::vector<std::vector<aicpp::real>>& X,
+    const std::vector<aicpp::real>& y) const
 {
     double total = 0;
     
@@ -25,36 +186,186 @@ double MultiLinearRegression::compute_loss(
     return total / X.size();
 }
 
+double MultiLinearRegression::compute_loss(const aicpp::Dataset& data) const
+{
+    const aicpp::Dataset rows = data.as_row_major();
+    double total = 0;
+
+    for (size_t i = 0; i < rows.rows(); i++) {
+        double err = predict(rows.row_ptr(i)) - rows.label(i);
+        total += err * err;
+    }
+    return total / rows.rows();
+}
+
 void MultiLinearRegression::train(
-    const std::vector<std::vector<double>>& X,
-    const std::vector<double>& y,
+    const std::vector<std::vector<aicpp::real>>& X,
+    const std::vector<aicpp::real>& y,
     int epochs)
 {
-    size_t n = X.size(), m = X[0].size();
+    train(aicpp::Dataset::from_rows(X, y), epochs);
+}
+
+void MultiLinearRegression::train(const aicpp::Dataset& data, int epochs)
+{
+    if (!data.has_labels() || data.empty())
+        throw std::runtime_error("Dataset must have rows and a label array.");
+
+    const aicpp::Dataset X = data.as_row_major();
+    if (solver_ == Solver::Direct) {
+        solve_direct(X);
+        return;
+    }
+
+    size_t n = X.rows(), m = X.cols();
     weights_.assign(m, 0.0);
+    bias_ = 0.0;
+    std::vector<double> grad_w(m);
 
     for (int e = 0; e <= epochs; e++) {
 
-        std::vector<double> grad_w(m, 0.0);
+        std::fill(grad_w.begin(), grad_w.end(), 0.0);
         double grad_b = 0;
 
         for (size_t i = 0; i < n; i++) {
             
-            double pred = predict(X[i]);
-            double err = pred - y[i];
+            const aicpp::real* x = X.row_ptr(i);
+            double err = predict(x) - X.label(i);
 
-            for (size_t j = 0; j < m; j++) grad_w[j] += err * X[i][j];
+            aicpp::simd::multiply_accumulate(err, x, grad_w.data(), m);
             grad_b += err;
         }
 
         for (size_t j = 0; j < m; j++)
-            weights_[j] -= learning_rate_ * grad_w[j] / n;
+            weights_[j] -= learning_rate_ * (grad_w[j] + ridge_ * weights_[j]) / n;
         bias_ -= learning_rate_ * grad_b / n;
 
         if (e % 500 == 0)
             std::cout << "Epoch " << e
-                      << " | Loss=" << compute_loss(X, y)
+                      << " | Loss=" << compute_loss(X)
                       << " | b=" << bias_ << "\n";
     }
 }
 
+void MultiLinearRegression::train(DatasetStream& stream, int epochs)
+{
+    if (!stream.has_labels() || stream.cols() == 0)
+        throw std::runtime_error("Stream must provide at least one feature and a label column.");
+
+    if (solver_ == Solver::Direct) {
+        solve_direct(stream);
+        return;
+    }
+
+    size_t m = stream.cols();
+    weights_.assign(m, 0.0);
+    bias_ = 0.0;
+
+    aicpp::Dataset batch;
+    std::vector<double> grad_w(m);
+
+    for (int e = 0; e <= epochs; e++) {
+
+        std::fill(grad_w.begin(), grad_w.end(), 0.0);
+        double grad_b = 0, loss = 0;
+        size_t n = 0;
+
+        stream.rewind();
+        while (stream.next_batch(batch)) {
+            for (size_t i = 0; i < batch.rows(); i++) {
+
+                const aicpp::real* x = batch.row_ptr(i);
+                double err = predict(x) - batch.label(i);
+
+                aicpp::simd::multiply_accumulate(err, x, grad_w.data(), m);
+                grad_b += err;
+                loss += err * err;
+            }
+            n += batch.rows();
+        }
+        if (n == 0) return;
+
+        for (size_t j = 0; j < m; j++)
+            weights_[j] -= learning_rate_ * (grad_w[j] + ridge_ * weights_[j]) / n;
+        bias_ -= learning_rate_ * grad_b / n;
+
+        // Loss is measured before this epoch's update (one pass per epoch)
+        if (e % 500 == 0)
+            std::cout << "Epoch " << e
+                      << " | Loss=" << loss / n
+                      << " | b=" << bias_ << "\n";
+    }
+}
+
+void MultiLinearRegression::set_solution(const std::vector<double>& w)
+{
+    weights_.assign(w.begin(), w.end() - 1);
+    bias_ = static_cast<aicpp::real>(w.back());
+}
+
+void MultiLinearRegression::solve_direct(const aicpp::Dataset& X)
+{
+    const size_t p = X.cols() + 1;
+
+    std::vector<NormalEquations> partial;
+    accumulate_parallel(X, p, partial, [&](NormalEquations& ne, size_t begin, size_t end) {
+        ne.add_rows(X, begin, end);
+    });
+    for (size_t c = 1; c < partial.size(); c++) partial[0].merge(partial[c]);
+
+    std::vector<double> w;
+    if (solve_cholesky(partial[0], ridge_, w)) {
+        set_solution(w);
+        report_direct("Cholesky", partial[0].mse(w), bias_);
+        return;
+    }
+
+    // Ill-conditioned: factor the design matrix itself instead of its square
+    std::vector<aicpp::IncrementalQR> qr;
+    accumulate_parallel(X, p, qr, [&](aicpp::IncrementalQR& q, size_t begin, size_t end) {
+        add_qr_rows(q, X, begin, end);
+    });
+    for (size_t c = 1; c < qr.size(); c++) qr[0].merge(qr[c]);
+    add_ridge_rows(qr[0], ridge_);
+
+    w = qr[0].solve();
+    set_solution(w);
+    report_direct("QR", partial[0].mse(w), bias_);
+}
+
+void MultiLinearRegression::solve_direct(DatasetStream& stream)
+{
+    const size_t p = stream.cols() + 1;
+    aicpp::Dataset batch;
+
+    std::vector<NormalEquations> partial;
+    stream.rewind();
+    while (stream.next_batch(batch)) {
+        accumulate_parallel(batch, p, partial, [&](NormalEquations& ne, size_t begin, size_t end) {
+            ne.add_rows(batch, begin, end);
+        });
+    }
+    if (partial.empty()) return;
+    for (size_t c = 1; c < partial.size(); c++) partial[0].merge(partial[c]);
+
+    std::vector<double> w;
+    if (solve_cholesky(partial[0], ridge_, w)) {
+        set_solution(w);
+        report_direct("Cholesky", partial[0].mse(w), bias_);
+        return;
+    }
+
+    std::vector<aicpp::IncrementalQR> qr;
+    stream.rewind();
+    while (stream.next_batch(batch)) {
+        accumulate_parallel(batch, p, qr, [&](aicpp::IncrementalQR& q, size_t begin, size_t end) {
+            add_qr_rows(q, batch, begin, end);
+        });
+    }
+    for (size_t c = 1; c < qr.size(); c++) qr[0].merge(qr[c]);
+    add_ridge_rows(qr[0], ridge_);
+
+    w = qr[0].solve();
+    set_solution(w);
+    report_direct("QR", partial[0].mse(w), bias_);
+}
@@ -1,21 +1,58 @@
 #pragma once
 #include <vector>
+#include "../../core/dataset.h"
+
+class DatasetStream;
 
 class MultiLinearRegression {
-    
+public:
+    // GradientDescent runs `epochs` full-batch steps. Direct solves the least-squares
+    // problem from one parallel pass over the data (Cholesky on XᵀX, with a QR pass
+    // when XᵀX is ill-conditioned) and ignores `epochs` and the learning rate.
+    enum class Solver { GradientDescent, Direct };
+
 private:
-    std::vector<double> weights_;
-    double bias_;
+    std::vector<aicpp::real> weights_;
+    aicpp::real bias_;
     double learning_rate_;
+    Solver solver_;
+    double ridge_;
+
+    void solve_direct(const aicpp::Dataset& X);
+    void solve_direct(DatasetStream& stream);
+    void set_solution(const std::vector<double>& w);
 
 public:
-    MultiLinearRegression(double learning_rate = 0.01);
-
-    double predict(const std::vector<double>& features) const;
-    double compute_loss(const std::vector<std::vector<double>>& X,
-                        const std::vector<double>& y) const;
-                        
-    void train(const std::vector<std::vector<double>>& X,
-               const std::vector<double>& y,
+    // ridge adds ridge * ||w||² to the summed squared error; the bias is not penalised
+    MultiLinearRegression(double learning_rate = 0.01,
+                          Solver solver = Solver::GradientDescent,
+                          double ridge = 0.0);
+
+    double predict(const std::vector<aicpp::real>& features) const;
+    double predict(const aicpp::real* features) const;
+
+    // Predictions for every row of X into out[0..X.rows()); blocked SIMD matrix-vector
+    // product split across the thread pool, for either layout
+    void predict_batch(const aicpp::Dataset& X, double* out) const;
+
+    // Same, for `rows` contiguous row-major rows of weights().size() features
+    void predict_batch(const aicpp::real* X, size_t rows, double* out) const;
+
+    double compute_loss(const std::vector<std::vector<aicpp::real>>& X,
+                        const std::vector<aicpp::real>& y) const;
+    double compute_loss(const aicpp::Dataset& data) const;
+
+    void train(const std::vector<std::vector<aicpp::real>>& X,
+               const std::vector<aicpp::real>& y,
                int epochs);
+
+    // Targets are taken from the dataset's label array
+    void train(const aicpp::Dataset& data, int epochs);
+
+    // Out-of-core training: one pass over the stream per epoch (a single pass, plus
+    // a QR pass if needed, for Solver::Direct); memory bounded by batch size
+    void train(DatasetStream& stream, int epochs);
+
+    const std::vector<aicpp::real>& weights() const { return weights_; }
+    aicpp::real bias() const { return bias_; }
 };
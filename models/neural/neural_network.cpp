@@ -1,6 +1,8 @@
 #include "neural_network.h"
+#include "core/simd.h"
 #include <random>
 #include <iostream>
+#include <stdexcept>
 
 namespace aicpp {
 
@@ -8,15 +10,15 @@ NeuralNetwork::NeuralNetwork(const std::vector<int>& layers, double learning_rat
     : layers_(layers), lr_(learning_rate) {
 
     std::mt19937 gen(12345);
-    std::uniform_real_distribution<double> dist(-0.5, 0.5);
+    std::uniform_real_distribution<real> dist(-0.5, 0.5);
 
     // allocate weights and biases for layers 1..L-1
     for (size_t l = 1; l < layers_.size(); ++l) {
         int neurons = layers_[l];
         int prev = layers_[l - 1];
 
-        weights_.push_back(std::vector<std::vector<double>>(neurons, std::vector<double>(prev)));
-        biases_.push_back(std::vector<double>(neurons, 0.0));
+        weights_.push_back(std::vector<std::vector<real>>(neurons, std::vector<real>(prev)));
+        biases_.push_back(std::vector<real>(neurons, 0));
 
         for (int i = 0; i < neurons; ++i) {
             for (int j = 0; j < prev; ++j) weights_.back()[i][j] = dist(gen);
@@ -29,26 +31,30 @@ NeuralNetwork::NeuralNetwork(const std::vector<int>& layers, double learning_rat
     zs_.resize(layers_.size()-1); // no z for input layer
 }
 
-double NeuralNetwork::sigmoid(double x) const {
-    return 1.0 / (1.0 + std::exp(-x));
+real NeuralNetwork::sigmoid(real x) const {
+    return real(1) / (real(1) + std::exp(-x));
 }
 
-double NeuralNetwork::sigmoid_derivative_from_activation(double a) const {
-    return a * (1.0 - a); // a = sigmoid(z)
+real NeuralNetwork::sigmoid_derivative_from_activation(real a) const {
+    return a * (real(1) - a); // a = sigmoid(z)
 }
 
-double NeuralNetwork::relu(double x) const {
-    return x > 0 ? x : 0.0;
+real NeuralNetwork::relu(real x) const {
+    return x > 0 ? x : real(0);
 }
 
-double NeuralNetwork::relu_derivative(double x) const {
-    return x > 0 ? 1.0 : 0.0;
+real NeuralNetwork::relu_derivative(real x) const {
+    return x > 0 ? real(1) : real(0);
 }
 
-std::vector<double> NeuralNetwork::forward(const std::vector<double>& x) const {
+std::vector<real> NeuralNetwork::forward(const std::vector<real>& x) const {
+    return forward(x.data());
+}
+
+const std::vector<real>& NeuralNetwork::forward(const real* x) const {
 
     // x -> activations_[0]
-    activations_[0] = x;
+    activations_[0].assign(x, x + layers_[0]);
 
     // For each layer l = 1..L-1
     for (size_t l = 1; l < layers_.size(); ++l) {
@@ -58,11 +64,7 @@ std::vector<double> NeuralNetwork::forward(const std::vector<double>& x) const {
         zs_[l-1].assign(neurons, 0.0);
 
         for (int i = 0; i < neurons; ++i) {
-            double z = biases_[l-1][i];
-
-            for (int j = 0; j < layers_[l-1]; ++j) {
-                z += weights_[l-1][i][j] * activations_[l-1][j];
-            }
+            real z = biases_[l-1][i] + simd::dot(weights_[l-1][i].data(), activations_[l-1].data(), layers_[l-1]);
             zs_[l-1][i] = z;
 
             // Activation: hidden -> ReLU, output -> sigmoid
@@ -76,11 +78,31 @@ std::vector<double> NeuralNetwork::forward(const std::vector<double>& x) const {
     return activations_.back();
 }
 
-void NeuralNetwork::train(const std::vector<std::vector<double>>& X,
-                          const std::vector<std::vector<double>>& Y,
+void NeuralNetwork::train(const std::vector<std::vector<real>>& X,
+                          const std::vector<std::vector<real>>& Y,
                           int epochs) {
 
-    const size_t N = X.size();
+    train_impl(X.size(),
+               [&](size_t n) { return X[n].data(); },
+               [&](size_t n) { return Y[n].data(); },
+               epochs);
+}
+
+void NeuralNetwork::train(const Dataset& data, int epochs) {
+
+    if (!data.has_labels()) throw std::runtime_error("Dataset must have a label array.");
+    if (layers_.back() != 1) throw std::runtime_error("Dataset labels provide a single output only.");
+
+    const Dataset X = data.as_row_major();
+    train_impl(X.rows(),
+               [&](size_t n) { return X.row_ptr(n); },
+               [&](size_t n) { return X.labels() + n; },
+               epochs);
+}
+
+template <typename InputFn, typename TargetFn>
+void NeuralNetwork::train_impl(size_t N, InputFn input, TargetFn target, int epochs) {
+
     if (N == 0) return;
 
     const int L = static_cast<int>(layers_.size());
@@ -103,12 +125,12 @@ void NeuralNetwork::train(const std::vector<std::vector<double>>& X,
         for (size_t n = 0; n < N; ++n) {
 
             // Forward pass (fills mutable activations_ and zs_)
-            forward(X[n]);
-            const std::vector<double>& out = activations_.back();
+            const std::vector<real>& out = forward(input(n));
+            const real* y_n = target(n);
 
             // Compute sample loss (binary: BCE simplified -> but we'll use (out - y)^2/2 for stability)
             for (size_t k = 0; k < out.size(); ++k) {
-                double diff = out[k] - Y[n][k];
+                double diff = out[k] - y_n[k];
                 total_loss += 0.5 * diff * diff;
             }
 
@@ -118,7 +140,7 @@ void NeuralNetwork::train(const std::vector<std::vector<double>>& X,
             delta[L-1].resize(layers_[L-1]);
             for (int i = 0; i < layers_[L-1]; ++i) {
                 double a = activations_[L-1][i];
-                double y = Y[n][i];
+                double y = y_n[i];
 
                 // Derivative for MSE with sigmoid output: (a - y) * sigmoid'(z)
                 double dz = (a - y) * sigmoid_derivative_from_activation(a);
@@ -146,9 +168,8 @@ void NeuralNetwork::train(const std::vector<std::vector<double>>& X,
 
                     grad_b[l-1][i] += delta[l][i];
                     
-                    for (int j = 0; j < layers_[l-1]; ++j) {
-                        grad_w[l-1][i][j] += delta[l][i] * activations_[l-1][j];
-                    }
+                    simd::multiply_accumulate(delta[l][i], activations_[l-1].data(),
+                                              grad_w[l-1][i].data(), layers_[l-1]);
                 }
             }
         } // end samples
@@ -172,11 +193,11 @@ void NeuralNetwork::train(const std::vector<std::vector<double>>& X,
     } // epochs
 }
 
-std::vector<double> NeuralNetwork::predict_proba(const std::vector<double>& x) const {
+std::vector<real> NeuralNetwork::predict_proba(const std::vector<real>& x) const {
     return forward(x);
 }
 
-int NeuralNetwork::predict_label(const std::vector<double>& x) const {
+int NeuralNetwork::predict_label(const std::vector<real>& x) const {
     auto p = predict_proba(x);
     return (p.size() > 0 && p[0] >= 0.5) ? 1 : 0;
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstdlib>
 #include <cmath>
+#include "core/dataset.h"
 
 namespace aicpp {
 
@@ -15,35 +16,43 @@ public:
 
     // Train with full-batch gradient descent
     // X: NxD, Y: NxO (for binary classification O=1)
-    void train(const std::vector<std::vector<double>>& X,
-               const std::vector<std::vector<double>>& Y,
+    void train(const std::vector<std::vector<real>>& X,
+               const std::vector<std::vector<real>>& Y,
                int epochs);
 
+    // Binary classification on a Dataset: labels are the single output target
+    void train(const Dataset& data, int epochs);
+
     // Predict probabilities (sigmoid outputs)
-    std::vector<double> predict_proba(const std::vector<double>& x) const;
+    std::vector<real> predict_proba(const std::vector<real>& x) const;
 
     // Predict class (0/1) using 0.5 threshold
-    int predict_label(const std::vector<double>& x) const;
+    int predict_label(const std::vector<real>& x) const;
 
 private:
     std::vector<int> layers_;
     double lr_;
 
     // weights_[l][i][j] — layer l (1..L-1), neuron i, prev neuron j
-    std::vector<std::vector<std::vector<double>>> weights_;
-    std::vector<std::vector<double>> biases_;
+    std::vector<std::vector<std::vector<real>>> weights_;
+    std::vector<std::vector<real>> biases_;
 
     // Helpers used per-sample during forward/backward
-    mutable std::vector<std::vector<double>> activations_; // size = layers_.size()
-    mutable std::vector<std::vector<double>> zs_;          // pre-activations (for hidden+out)
+    mutable std::vector<std::vector<real>> activations_; // size = layers_.size()
+    mutable std::vector<std::vector<real>> zs_;          // pre-activations (for hidden+out)
+
+    real sigmoid(real x) const;
+    real sigmoid_derivative_from_activation(real a) const;
 
-    double sigmoid(double x) const;
-    double sigmoid_derivative_from_activation(double a) const;
+    real relu(real x) const;
+    real relu_derivative(real x) const;
 
-    double relu(double x) const;
-    double relu_derivative(double x) const;
+    std::vector<real> forward(const std::vector<real>& x) const;
+    const std::vector<real>& forward(const real* x) const;
 
-    std::vector<double> forward(const std::vector<double>& x) const;
+    // Full-batch gradient descent over N samples given by input(n) / target(n) pointers
+    template <typename InputFn, typename TargetFn>
+    void train_impl(size_t N, InputFn input, TargetFn target, int epochs);
 };
 
 } // namespace aicpp